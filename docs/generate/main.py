@@ -12,6 +12,7 @@ for repo_file_name, docs_file_name in [
     ("README.md", "index.md"),
     ("ROADMAP.md", "roadmap.md"),
     ("getting_started.md", "getting_started.md"),
+    ("CHANGELOG.md", "changelog.md"),
 ]:
     with mkdocs_gen_files.open(docs_file_name, "w") as f:
         with open(repo_file_name) as repo_file:
@@ -321,7 +321,7 @@ public:
   }
 
   void initialize() {
-    engine.display.drawBitmap(0, 0, KYWY_DISPLAY_WIDTH, KYWY_DISPLAY_HEIGHT, (uint8_t *)splashScreen);
+    engine.display.drawBitmap(0, 0, KYWY_DISPLAY_WIDTH, KYWY_DISPLAY_HEIGHT, splashScreen);
     engine.display.update();
     subscribe(&engine.input);
   }
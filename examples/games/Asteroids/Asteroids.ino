@@ -556,7 +556,7 @@ public:
           asteroidManager.unsubscribe(&engine.clock);
           bulletManager.unsubscribe(&engine.clock);
           unsubscribe(&engine.clock);
-          engine.display.drawBitmap(0, 0, 144, 168, (uint8_t *)asteroidSplashScreen);
+          engine.display.drawBitmap(0, 0, 144, 168, asteroidSplashScreen);
           engine.display.update();
           subscribe(&engine.input);
           break;
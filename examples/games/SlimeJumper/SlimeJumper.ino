@@ -285,10 +285,9 @@ const uint8_t spriteSheetData[] = {
   0x00, 0x7f, 0xfe, 0x00
 };
 
-::SpriteSheet spriteSheet = ::SpriteSheet(spriteSheetData, 96, 32, 3);
+::SpriteSheet spriteSheet(spriteSheetData, 96, 32, 3);
 
-const uint8_t *frames[] = {};
-Sprite slime(frames, 3, 32, 32);
+Sprite slime(spriteSheet.frames, 3, 32, 32);  // frames are filled in by `addFrames` in setup
 
 typedef enum : uint16_t {
   START_SCREEN = Kywy::Events::USER_EVENTS,
@@ -494,7 +493,7 @@ public:
           slimeManager.unsubscribe(&engine.clock);
           platformManager.unsubscribe(&engine.clock);
           unsubscribe(&engine.clock);
-          engine.display.drawBitmap(0, 0, 144, 168, (uint8_t *)slimeJumperSplashScreenBMP);
+          engine.display.drawBitmap(0, 0, 144, 168, slimeJumperSplashScreenBMP);
           engine.display.update();
           subscribe(&engine.input);
           break;
@@ -554,7 +553,6 @@ void setup() {
   engine.start();
 
   spriteSheet.addFrames(0, 0, 32, 32, 3);
-  slime.frames = spriteSheet.frames;
   slime.setDisplay(&engine.display);
 
   // set up game managers
@@ -474,7 +474,7 @@ public:
           spelunkerManager.unsubscribe(&engine.clock);
           columnManager.unsubscribe(&engine.clock);
           unsubscribe(&engine.clock);
-          engine.display.drawBitmap(0, 0, 144, 168, (uint8_t *)splashScreenBMP);
+          engine.display.drawBitmap(0, 0, 144, 168, splashScreenBMP);
           engine.display.update();
           subscribe(&engine.input);
           break;
@@ -266,7 +266,7 @@ void drawPlantSprite() {
     engine.display.drawBitmap(spriteX, spriteY,
                               PLANT_FRAME_WIDTH,
                               PLANT_FRAME_HEIGHT,
-                              (uint8_t*)frameData);
+                              frameData);
   }
 }
 
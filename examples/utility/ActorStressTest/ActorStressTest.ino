@@ -0,0 +1,169 @@
+// SPDX-FileCopyrightText: 2025 KOINSLOT, Inc.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// Stress test for actor message delivery
+//
+// Notes:
+//   - messages from one actor to another are always handled in the order they
+//     were dispatched, no matter how many other actors are sending
+//   - the senders and receivers here don't share any state so they run without
+//     a handler lock, in parallel with each other
+//
+// This example:
+//   - has a few senders that each send numbered messages to every receiver on
+//     every tick
+//   - the receivers check every message arrives in order from each sender
+//   - the reporter prints the results to the screen and the Serial Monitor
+//     along with the average and worst dispatch latency and how full the
+//     message pool got
+//   - set COOPERATIVE to true to run the same test on the cooperative scheduler
+
+#include "Kywy.hpp"
+
+#define COOPERATIVE false
+
+#define SENDERS 3
+#define RECEIVERS 3
+#define MESSAGES_PER_PAIR 2000
+#define BURST 4  // messages each sender sends each receiver per tick
+
+Kywy::Engine engine;
+
+enum {
+  STRESS_MESSAGE = Kywy::Events::USER_EVENTS,
+};
+
+struct Payload {
+  uint8_t sender;
+  uint32_t sequence;
+};
+
+class Receiver : public Actor::Actor {
+public:
+  uint32_t expected[SENDERS] = {};
+  uint32_t received = 0;
+  uint32_t outOfOrder = 0;
+  uint32_t lost = 0;
+
+  void handle(::Actor::Message *message) {
+    if (message->signal != STRESS_MESSAGE) {
+      return;
+    }
+
+    Payload payload = message->getPayload<Payload>();
+    received++;
+
+    if (payload.sequence < expected[payload.sender]) {
+      outOfOrder++;
+      return;
+    }
+
+    lost += payload.sequence - expected[payload.sender];  // dropped by a full queue or pool
+    expected[payload.sender] = payload.sequence + 1;
+  }
+} receivers[RECEIVERS];
+
+class Sender : public Actor::Actor {
+public:
+  uint8_t id;
+  uint32_t sent = 0;  // per receiver
+
+  void handle(::Actor::Message *message) {
+    if (message->signal != Kywy::Events::TICK) {
+      return;
+    }
+
+    for (uint8_t burst = 0; burst < BURST && sent < MESSAGES_PER_PAIR; burst++, sent++) {
+      Payload payload = { id, sent };
+
+      // copied when dispatched, so one message can be reused for every receiver
+      ::Actor::Message stressMessage(STRESS_MESSAGE);
+      stressMessage.setPayload(payload);
+
+      for (uint8_t receiver = 0; receiver < RECEIVERS; receiver++) {
+        receivers[receiver].dispatch(stressMessage);
+      }
+    }
+  }
+} senders[SENDERS];
+
+class Reporter : public Actor::Actor {
+public:
+  bool reported = false;
+
+  void handle(::Actor::Message *message) {
+    if (message->signal != Kywy::Events::TICK || reported) {
+      return;
+    }
+
+    uint32_t received = 0, outOfOrder = 0, lost = 0;
+    for (uint8_t i = 0; i < RECEIVERS; i++) {
+      received += receivers[i].received;
+      outOfOrder += receivers[i].outOfOrder;
+      lost += receivers[i].lost;
+    }
+
+    bool sending = false;
+    for (uint8_t i = 0; i < SENDERS; i++) {
+      sending = sending || senders[i].sent < MESSAGES_PER_PAIR;
+    }
+
+    if (!sending && received + lost < (uint32_t)SENDERS * RECEIVERS * MESSAGES_PER_PAIR) {
+      return;  // wait for the last messages to be handled
+    }
+
+    char msg[32];
+    engine.display.clear();
+
+    snprintf(msg, sizeof(msg), "received: %lu", (unsigned long)received);
+    engine.display.drawText(5, 10, msg);
+    snprintf(msg, sizeof(msg), "out of order: %lu", (unsigned long)outOfOrder);
+    engine.display.drawText(5, 25, msg);
+    snprintf(msg, sizeof(msg), "lost: %lu", (unsigned long)lost);
+    engine.display.drawText(5, 40, msg);
+    snprintf(msg, sizeof(msg), "avg latency: %luus", (unsigned long)::Actor::dispatchStats.getAverageLatency());
+    engine.display.drawText(5, 55, msg);
+    snprintf(msg, sizeof(msg), "max latency: %luus", (unsigned long)::Actor::dispatchStats.maxLatency);
+    engine.display.drawText(5, 70, msg);
+    snprintf(msg, sizeof(msg), "pool high water: %u", (unsigned)::Actor::messagePool.getHighWater());
+    engine.display.drawText(5, 85, msg);
+    engine.display.drawText(5, 105, sending ? "running..." : (outOfOrder ? "FAILED" : "PASSED"));
+
+    engine.display.update();
+
+    if (!sending) {
+      char report[128];
+      snprintf(report, sizeof(report), "received: %lu, out of order: %lu, lost: %lu, avg latency: %luus, max latency: %luus, pool high water: %u",
+               (unsigned long)received, (unsigned long)outOfOrder, (unsigned long)lost,
+               (unsigned long)::Actor::dispatchStats.getAverageLatency(),
+               (unsigned long)::Actor::dispatchStats.maxLatency,
+               (unsigned)::Actor::messagePool.getHighWater());
+      Serial.println(report);
+      reported = true;
+    }
+  }
+} reporter;
+
+void setup() {
+  engine.start(Kywy::EngineOptions().cooperativeScheduler(COOPERATIVE));
+
+  for (uint8_t i = 0; i < RECEIVERS; i++) {
+    receivers[i].setHandlerLock(nullptr);
+    receivers[i].start();
+  }
+
+  for (uint8_t i = 0; i < SENDERS; i++) {
+    senders[i].id = i;
+    senders[i].setHandlerLock(nullptr);
+    senders[i].subscribe(&engine.clock);
+    senders[i].start();
+  }
+
+  reporter.subscribe(&engine.clock);
+  reporter.start();
+}
+
+void loop() {
+  delay(1000);
+}
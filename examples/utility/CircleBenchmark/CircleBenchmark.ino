@@ -0,0 +1,72 @@
+// SPDX-FileCopyrightText: 2025 KOINSLOT, Inc.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// Measures how many circles can be drawn per second
+//
+// Notes:
+//   - circles, ellipses, arcs and rounded rectangles are written to the frame
+//     buffer as spans, a run of pixels on one row, so the time goes up with
+//     the number of rows rather than the number of pixels
+//   - only drawing into the frame buffer is timed, not sending it to the
+//     display
+//
+// This example:
+//   - draws and fills circles of each diameter in DIAMETERS for a second each
+//   - prints circles per second for each to the Serial Monitor, along with
+//     ellipses and rounded rectangles of the same size for comparison
+//   - shows the last shape drawn on screen
+
+#include "Kywy.hpp"
+
+Kywy::Engine engine;
+
+const uint16_t DIAMETERS[] = { 4, 8, 16, 32, 64, 128 };
+
+// draws `shape` for a second and returns how many were drawn
+template<typename Shape>
+uint32_t perSecond(Shape shape) {
+  uint32_t count = 0;
+  uint32_t start = millis();
+  while (millis() - start < 1000) {
+    for (int i = 0; i < 16; i++) {
+      shape(count++);
+    }
+  }
+  return count;
+}
+
+void benchmark() {
+  Display::Object2DOptions options = Display::Object2DOptions().origin(Display::Origin::Object2D::CENTER);
+  char msg[128];
+
+  for (uint16_t diameter : DIAMETERS) {
+    engine.display.clear();
+    uint32_t drawn = perSecond([&](uint32_t i) {
+      engine.display.drawCircle(72 + i % 7, 84, diameter, options);
+    });
+    uint32_t filled = perSecond([&](uint32_t i) {
+      engine.display.fillCircle(72 + i % 7, 84, diameter, options);
+    });
+    uint32_t ellipses = perSecond([&](uint32_t i) {
+      engine.display.fillEllipse(72 + i % 7, 84, diameter, diameter / 2 + 1, options);
+    });
+    uint32_t roundedRectangles = perSecond([&](uint32_t i) {
+      engine.display.fillRoundedRectangle(72 + i % 7, 84, diameter, diameter, diameter / 4, options);
+    });
+    engine.display.update();
+
+    snprintf(msg, sizeof(msg), "diameter %3u: drawCircle %7lu/s, fillCircle %7lu/s, fillEllipse %7lu/s, fillRoundedRectangle %7lu/s",
+             diameter, (unsigned long)drawn, (unsigned long)filled, (unsigned long)ellipses, (unsigned long)roundedRectangles);
+    Serial.println(msg);
+  }
+}
+
+void setup() {
+  engine.start();
+}
+
+void loop() {
+  benchmark();
+  delay(5000);
+}
@@ -0,0 +1,97 @@
+// SPDX-FileCopyrightText: 2025 KOINSLOT, Inc.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// Measures how many pairs a `Collider` tests per frame
+//
+// Notes:
+//   - the collider's spatial hash only tests objects that share a cell, so the
+//     pair tests grow with how crowded the screen is, not with the square of
+//     the number of objects
+//   - pixel-perfect tests only run for pairs whose bounds overlap
+//
+// This example:
+//   - bounces 120 pixel-perfect balls around the screen
+//   - checks for collisions every tick
+//   - prints the average pair tests, pixel tests, collisions and time per
+//     check to the Serial Monitor once a second, next to the pairs a brute
+//     force check would test
+
+#include "Kywy.hpp"
+
+#define BALLS 120
+
+Kywy::Engine engine;
+
+// 8x8 ball
+const uint8_t ball[] = { 0xc3, 0x81, 0x00, 0x00, 0x00, 0x00, 0x81, 0xc3 };
+const uint8_t *ballFrames[] = { ball };
+
+class Bouncer : public Actor::Actor {
+public:
+  Sprite *balls[BALLS];
+  int8_t dx[BALLS], dy[BALLS];
+  Collider collider;
+
+  uint32_t frames = 0, totalTime = 0;
+  ColliderStats lastStats;
+
+  void initialize() {
+    for (int i = 0; i < BALLS; i++) {
+      balls[i] = new Sprite(ballFrames, 1, 8, 8);
+      balls[i]->setDisplay(&engine.display);
+      balls[i]->setPosition(random(0, KYWY_DISPLAY_WIDTH - 8), random(0, KYWY_DISPLAY_HEIGHT - 8));
+      balls[i]->setVisible(true);
+      dx[i] = random(0, 2) ? 1 : -1;
+      dy[i] = random(0, 2) ? 1 : -1;
+      collider.add(balls[i], ColliderOptions().pixelPerfect(true));
+    }
+  }
+
+  void handle(::Actor::Message *message) {
+    switch (message->signal) {
+      case Kywy::Events::TICK:
+        {
+          for (int i = 0; i < BALLS; i++) {
+            Sprite *ball = balls[i];
+            if (ball->x + dx[i] < 0 || ball->x + dx[i] > KYWY_DISPLAY_WIDTH - 8)
+              dx[i] = -dx[i];
+            if (ball->y + dy[i] < 0 || ball->y + dy[i] > KYWY_DISPLAY_HEIGHT - 8)
+              dy[i] = -dy[i];
+            ball->translate(dx[i], dy[i]);
+          }
+
+          uint32_t start = micros();
+          collider.check();
+          totalTime += micros() - start;
+
+          engine.display.clear();
+          for (int i = 0; i < BALLS; i++) {
+            balls[i]->render();
+          }
+          engine.display.update();
+
+          if (++frames == 30) {
+            ColliderStats &stats = collider.stats;
+            char msg[128];
+            snprintf(msg, sizeof(msg), "%lu pair tests, %lu pixel tests, %lu collisions, %luus per check (brute force: %d pairs)",
+                     (unsigned long)((stats.pairTests - lastStats.pairTests) / frames),
+                     (unsigned long)((stats.pixelTests - lastStats.pixelTests) / frames),
+                     (unsigned long)((stats.collisions - lastStats.collisions) / frames),
+                     (unsigned long)(totalTime / frames), BALLS * (BALLS - 1) / 2);
+            Serial.println(msg);
+            lastStats = stats;
+            frames = totalTime = 0;
+          }
+          break;
+        }
+    }
+  }
+} bouncer;
+
+void setup() {
+  engine.start();
+
+  bouncer.subscribe(&engine.clock);
+  bouncer.start();
+}
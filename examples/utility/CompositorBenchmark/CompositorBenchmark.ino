@@ -0,0 +1,111 @@
+// SPDX-FileCopyrightText: 2025 KOINSLOT, Inc.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// Compares a `Compositor` with clearing and redrawing the whole screen
+//
+// Notes:
+//   - the compositor only repaints the rectangles sprites moved out of and
+//     into, and only the display lines those cover are sent
+//   - clearing and redrawing repaints everything and sends every line that
+//     had something on it
+//
+// This example:
+//   - bounces 30 sprites around the screen, MOVING of them move each tick
+//   - press the left button to switch between the compositor and clearing and
+//     redrawing
+//   - prints the average time to draw and send a frame, and the lines sent per
+//     frame, to the Serial Monitor once a second
+
+#include "Kywy.hpp"
+
+#define SPRITES 30
+#define MOVING 5
+
+Kywy::Engine engine;
+
+// 16x16 ball
+const uint8_t ball[] = {
+  0xf8, 0x1f, 0xe0, 0x07, 0xc0, 0x03, 0x80, 0x01, 0x80, 0x01, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0x01,
+  0x80, 0x01, 0xc0, 0x03, 0xe0, 0x07, 0xf8, 0x1f
+};
+const uint8_t *ballFrames[] = { ball };
+
+class Bouncer : public Actor::Actor {
+public:
+  Sprite *sprites[SPRITES];
+  int8_t dx[SPRITES], dy[SPRITES];
+  Compositor compositor;
+  bool composite = true;
+
+  uint32_t frames = 0, totalTime = 0, totalLines = 0;
+
+  void initialize() {
+    compositor.display = &engine.display;
+    for (int i = 0; i < SPRITES; i++) {
+      sprites[i] = new Sprite(ballFrames, 1, 16, 16);
+      sprites[i]->setDisplay(&engine.display);
+      sprites[i]->setPosition(random(0, KYWY_DISPLAY_WIDTH - 16), random(0, KYWY_DISPLAY_HEIGHT - 16));
+      sprites[i]->setVisible(true);
+      dx[i] = random(0, 2) ? 1 : -1;
+      dy[i] = random(0, 2) ? 1 : -1;
+      compositor.add(sprites[i]);
+    }
+  }
+
+  void handle(::Actor::Message *message) {
+    switch (message->signal) {
+      case Kywy::Events::BUTTON_LEFT_PRESSED:
+        {
+          composite = !composite;
+          compositor.invalidate();  // the screen was drawn without it
+          break;
+        }
+      case Kywy::Events::TICK:
+        {
+          for (int i = 0; i < MOVING; i++) {
+            int s = (message->getPayload<Kywy::Tick>().frame * MOVING + i) % SPRITES;
+            Sprite *sprite = sprites[s];
+            if (sprite->x + dx[s] < 0 || sprite->x + dx[s] > KYWY_DISPLAY_WIDTH - 16)
+              dx[s] = -dx[s];
+            if (sprite->y + dy[s] < 0 || sprite->y + dy[s] > KYWY_DISPLAY_HEIGHT - 16)
+              dy[s] = -dy[s];
+            sprite->translate(dx[s], dy[s]);
+          }
+
+          uint32_t start = micros();
+          if (composite) {
+            compositor.render();
+          } else {
+            engine.display.clear();
+            for (int i = 0; i < SPRITES; i++) {
+              sprites[i]->render();
+            }
+          }
+          engine.display.update();
+          engine.display.waitForFlush();
+          totalTime += micros() - start;
+          totalLines += ((Display::Driver::MBED_SPI_DRIVER *)engine.display.driver)->getLinesSent();
+
+          if (++frames == 30) {
+            char msg[64];
+            snprintf(msg, sizeof(msg), "%s: %luus/frame, %lu lines/frame",
+                     composite ? "compositor" : "clear and redraw",
+                     (unsigned long)(totalTime / frames), (unsigned long)(totalLines / frames));
+            Serial.println(msg);
+            frames = totalTime = totalLines = 0;
+          }
+          break;
+        }
+    }
+  }
+} bouncer;
+
+void setup() {
+  engine.start();
+
+  bouncer.subscribe(&engine.clock);
+  bouncer.subscribe(&engine.input);
+  bouncer.start();
+}
@@ -0,0 +1,132 @@
+// SPDX-FileCopyrightText: 2025 KOINSLOT, Inc.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// Compares `FixedPoint` math with libm
+//
+// Notes:
+//   - the RP2040 has no FPU, every float and double operation is a library
+//     call
+//   - errors are the largest difference from the double precision libm result
+//     over every input tested, in units of 1/65536 (of a turn for atan2)
+//
+// This example:
+//   - times each function over CALLS calls, including the loop
+//   - prints cycles per call for FixedPoint, float libm and double libm, and
+//     FixedPoint's error, to the Serial Monitor every 5 seconds
+
+#include "Kywy.hpp"
+
+#define CALLS 4096
+
+Kywy::Engine engine;
+
+volatile int32_t fixedSink;
+volatile float floatSink;
+volatile double doubleSink;
+
+uint32_t toCycles(uint32_t micros) {
+  return (uint64_t)micros * (SystemCoreClock / 1000000) / CALLS;
+}
+
+void report(const char *name, uint32_t fixedMicros, uint32_t floatMicros, uint32_t doubleMicros, double error) {
+  char msg[128];
+  snprintf(msg, sizeof(msg), "%-7s fixed %5lu, float %5lu, double %5lu cycles/call, error %.2f",
+           name, (unsigned long)toCycles(fixedMicros), (unsigned long)toCycles(floatMicros),
+           (unsigned long)toCycles(doubleMicros), error);
+  Serial.println(msg);
+}
+
+void benchmark() {
+  uint32_t start, fixedMicros, floatMicros, doubleMicros;
+  double error = 0;
+
+  // sin
+  start = micros();
+  for (uint32_t i = 0; i < CALLS; i++)
+    fixedSink = FixedPoint::sin(i * 16);
+  fixedMicros = micros() - start;
+  start = micros();
+  for (uint32_t i = 0; i < CALLS; i++)
+    floatSink = sinf(i * (float)(2 * M_PI / CALLS));
+  floatMicros = micros() - start;
+  start = micros();
+  for (uint32_t i = 0; i < CALLS; i++)
+    doubleSink = sin(i * (2 * M_PI / CALLS));
+  doubleMicros = micros() - start;
+  for (uint32_t angle = 0; angle < 65536; angle++)
+    error = fmax(error, fabs(FixedPoint::sin(angle) - sin(angle * (2 * M_PI / 65536)) * 65536));
+  report("sin", fixedMicros, floatMicros, doubleMicros, error);
+
+  // atan2
+  error = 0;
+  start = micros();
+  for (int32_t i = 0; i < CALLS; i++)
+    fixedSink = FixedPoint::atan2(FixedPoint::fromInt(i - CALLS / 2), FixedPoint::fromInt(CALLS / 4));
+  fixedMicros = micros() - start;
+  start = micros();
+  for (int32_t i = 0; i < CALLS; i++)
+    floatSink = atan2f(i - CALLS / 2, CALLS / 4);
+  floatMicros = micros() - start;
+  start = micros();
+  for (int32_t i = 0; i < CALLS; i++)
+    doubleSink = atan2(i - CALLS / 2, CALLS / 4);
+  doubleMicros = micros() - start;
+  for (int32_t y = -100; y <= 100; y++) {
+    for (int32_t x = -100; x <= 100; x++) {
+      double expected = atan2(y, x) * (65536 / (2 * M_PI));
+      double difference = fabs(FixedPoint::atan2(FixedPoint::fromInt(y), FixedPoint::fromInt(x)) - (expected < 0 ? expected + 65536 : expected));
+      error = fmax(error, fmin(difference, 65536 - difference));
+    }
+  }
+  report("atan2", fixedMicros, floatMicros, doubleMicros, error);
+
+  // sqrt
+  error = 0;
+  start = micros();
+  for (uint32_t i = 0; i < CALLS; i++)
+    fixedSink = FixedPoint::sqrt(i * 40503);
+  fixedMicros = micros() - start;
+  start = micros();
+  for (uint32_t i = 0; i < CALLS; i++)
+    floatSink = sqrtf(i * 0.618f);
+  floatMicros = micros() - start;
+  start = micros();
+  for (uint32_t i = 0; i < CALLS; i++)
+    doubleSink = sqrt(i * 0.618);
+  doubleMicros = micros() - start;
+  for (uint32_t i = 0; i < 65536; i++) {
+    FixedPoint::Fixed value = i * 32749;
+    error = fmax(error, fabs(FixedPoint::sqrt(value) - sqrt(value / 65536.0) * 65536));
+  }
+  report("sqrt", fixedMicros, floatMicros, doubleMicros, error);
+
+  // integer square root, against libm's rounded down
+  error = 0;
+  start = micros();
+  for (uint32_t i = 0; i < CALLS; i++)
+    fixedSink = FixedPoint::squareRoot(i * i + i);
+  fixedMicros = micros() - start;
+  start = micros();
+  for (uint32_t i = 0; i < CALLS; i++)
+    floatSink = (uint32_t)sqrtf(i * i + i);
+  floatMicros = micros() - start;
+  start = micros();
+  for (uint32_t i = 0; i < CALLS; i++)
+    doubleSink = (uint32_t)sqrt(i * i + i);
+  doubleMicros = micros() - start;
+  for (uint32_t i = 0; i < 65536; i++) {
+    uint32_t value = i * 65521;
+    error = fmax(error, fabs((double)FixedPoint::squareRoot(value) - floor(sqrt(value))));
+  }
+  report("isqrt", fixedMicros, floatMicros, doubleMicros, error);
+}
+
+void setup() {
+  engine.start();
+}
+
+void loop() {
+  benchmark();
+  delay(5000);
+}
@@ -0,0 +1,103 @@
+// SPDX-FileCopyrightText: 2025 KOINSLOT, Inc.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// Measures how long button presses take to reach an actor
+//
+// Notes:
+//   - every button press and release message carries a `Kywy::ButtonEvent`
+//     with the micros() the change was seen at (`time`) and of the read of
+//     the buttons before that (`since`), the change happened in between
+//   - when polling (the default) buttons are read once per tick, so a press
+//     waits up to a whole tick (33ms) before it's even seen, and presses
+//     shorter than a tick can be missed
+//   - with interrupts presses are seen as they happen, `since` and `time` are
+//     the same
+//   - extras/host/tests/InputLatencyTest.cpp checks these figures against
+//     simulated presses with known times
+//
+// This example:
+//   - counts presses and shows the average and worst time from a press being
+//     seen to this actor handling it
+//   - shows the time from the press itself to this actor handling it, the
+//     average is estimated as half way between the two reads, the worst case
+//     is from the read before
+//   - shows how many changes were ignored as contact bounce
+//   - set INTERRUPTS to true to compare with interrupt driven input
+
+#include "Kywy.hpp"
+
+#define INTERRUPTS false
+
+Kywy::Engine engine;
+
+class LatencyMeter : public Actor::Actor {
+public:
+  uint32_t presses = 0;
+  uint32_t maxLatency = 0;  // from being seen
+  uint64_t totalLatency = 0;
+  uint32_t maxPressLatency = 0;  // from the press, at worst
+  uint64_t totalPressLatency = 0;  // from the press, estimated
+
+  void handle(::Actor::Message *message) {
+    switch (message->signal) {
+      case Kywy::Events::BUTTON_LEFT_PRESSED:
+      case Kywy::Events::BUTTON_RIGHT_PRESSED:
+      case Kywy::Events::D_PAD_LEFT_PRESSED:
+      case Kywy::Events::D_PAD_RIGHT_PRESSED:
+      case Kywy::Events::D_PAD_UP_PRESSED:
+      case Kywy::Events::D_PAD_DOWN_PRESSED:
+      case Kywy::Events::D_PAD_CENTER_PRESSED:
+        {
+          Kywy::ButtonEvent event = message->getPayload<Kywy::ButtonEvent>();
+          uint32_t now = micros();
+          uint32_t latency = now - event.time;
+          uint32_t worst = now - event.since;
+          presses++;
+          totalLatency += latency;
+          maxLatency = latency > maxLatency ? latency : maxLatency;
+          totalPressLatency += latency + (event.time - event.since) / 2;
+          maxPressLatency = worst > maxPressLatency ? worst : maxPressLatency;
+          break;
+        }
+      case Kywy::Events::TICK:
+        {
+          char msg[32];
+          engine.display.clear();
+
+          engine.display.drawText(5, 10, INTERRUPTS ? "mode: interrupts" : "mode: polling");
+          snprintf(msg, sizeof(msg), "presses: %lu", (unsigned long)presses);
+          engine.display.drawText(5, 25, msg);
+          engine.display.drawText(5, 40, "seen to handled");
+          snprintf(msg, sizeof(msg), " avg %luus", (unsigned long)(presses ? totalLatency / presses : 0));
+          engine.display.drawText(5, 52, msg);
+          snprintf(msg, sizeof(msg), " max %luus", (unsigned long)maxLatency);
+          engine.display.drawText(5, 64, msg);
+          engine.display.drawText(5, 79, "pressed to handled");
+          snprintf(msg, sizeof(msg), " avg ~%luus", (unsigned long)(presses ? totalPressLatency / presses : 0));
+          engine.display.drawText(5, 91, msg);
+          snprintf(msg, sizeof(msg), " worst %luus", (unsigned long)maxPressLatency);
+          engine.display.drawText(5, 103, msg);
+          snprintf(msg, sizeof(msg), "bounces: %lu", (unsigned long)engine.input.stats.bounces);
+          engine.display.drawText(5, 118, msg);
+          snprintf(msg, sizeof(msg), "dropped: %lu", (unsigned long)engine.input.stats.dropped);
+          engine.display.drawText(5, 133, msg);
+
+          engine.display.update();
+          break;
+        }
+    }
+  }
+} latencyMeter;
+
+void setup() {
+  engine.start(Kywy::EngineOptions().interruptInput(INTERRUPTS));
+
+  latencyMeter.subscribe(&engine.clock);
+  latencyMeter.subscribe(&engine.input);
+  latencyMeter.start();
+}
+
+void loop() {
+  delay(1000);
+}
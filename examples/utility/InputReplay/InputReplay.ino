@@ -0,0 +1,145 @@
+// SPDX-FileCopyrightText: 2025 KOINSLOT, Inc.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// Records input and replays it as fast as possible
+//
+// Notes:
+//   - a log has an entry for every run of ticks with the same buttons, so a
+//     few hundred bytes cover minutes of play
+//   - during replay the clock free runs: ticks are published back to back, so
+//     this measures how many ticks and display updates per second the game
+//     can do
+//   - with the cooperative scheduler every message a tick causes is handled
+//     before the next tick, so the replay is exactly the same every run
+//   - the log is printed to the Serial Monitor as a C array, paste it into any
+//     sketch to benchmark it with the same input (see the Debug Tools guide)
+//   - the dot only reads INPUT_STATE, so button events are turned off and
+//     input sends one message per tick instead of one per press and release
+//
+// This example:
+//   - lets you move a dot around with the d-pad for RECORD_TICKS ticks while
+//     the input is recorded
+//   - then puts the dot back and replays the recording, free running
+//   - shows where the dot ended up both times, and the replay's ticks and
+//     display updates per second
+
+#include "Kywy.hpp"
+
+#define RECORD_TICKS 300  // 10 seconds
+
+Kywy::Engine engine;
+
+uint8_t recording[1024];
+uint16_t recordingLength = 0;
+
+class Dot : public Actor::Actor {
+public:
+  int16_t x = KYWY_DISPLAY_WIDTH / 2, y = KYWY_DISPLAY_HEIGHT / 2;
+  int16_t recordedX, recordedY;
+  uint32_t ticks = 0;  // input states handled
+  bool replaying = false, finished = false;
+  uint32_t replayStartedAt, replayUpdates;
+  uint32_t replayTime, replayTicks;
+
+  void handle(::Actor::Message *message) {
+    if (finished) {
+      return;  // the clock keeps going for a moment after the replay
+    }
+
+    switch (message->signal) {
+      case Kywy::Events::INPUT_STATE:
+        {
+          Kywy::InputState state = message->getPayload<Kywy::InputState>();
+          x += (state.held & Kywy::buttonMask(Kywy::D_PAD_RIGHT)) ? 1 : 0;
+          x -= (state.held & Kywy::buttonMask(Kywy::D_PAD_LEFT)) ? 1 : 0;
+          y += (state.held & Kywy::buttonMask(Kywy::D_PAD_DOWN)) ? 1 : 0;
+          y -= (state.held & Kywy::buttonMask(Kywy::D_PAD_UP)) ? 1 : 0;
+
+          ticks++;
+          if (!replaying && ticks == RECORD_TICKS) {
+            startReplay();
+          }
+          break;
+        }
+      case Kywy::Events::TICK:
+        {
+          engine.display.clear();
+          engine.display.fillCircle(x, y, 5, Display::Object2DOptions().origin(Display::Origin::Object2D::CENTER));
+          engine.display.drawText(5, 5, replaying ? "replaying..." : "recording...");
+          engine.display.update();
+          break;
+        }
+      case Kywy::Events::REPLAY_FINISHED:
+        {
+          engine.clock.setFreeRunning(false);
+          replayTime = millis() - replayStartedAt;
+          replayUpdates = engine.display.getUpdates() - replayUpdates;
+          finished = true;
+          showResults();
+          break;
+        }
+    }
+  }
+
+  void startReplay() {
+    recordingLength = engine.input.stopRecording();
+    printRecording();
+
+    recordedX = x;
+    recordedY = y;
+    x = KYWY_DISPLAY_WIDTH / 2;
+    y = KYWY_DISPLAY_HEIGHT / 2;
+
+    replaying = true;
+    replayStartedAt = millis();
+    replayUpdates = engine.display.getUpdates();
+    replayTicks = ticks;
+    engine.input.startReplay(recording, recordingLength);
+    engine.clock.setFreeRunning(true);
+  }
+
+  void printRecording() {
+    char line[16];
+    Serial.println("const uint8_t inputLog[] = {");
+    for (uint16_t i = 0; i < recordingLength; i += INPUT_LOG_ENTRY_SIZE) {
+      snprintf(line, sizeof(line), "  %u, %u, %u,", recording[i], recording[i + 1], recording[i + 2]);
+      Serial.println(line);
+    }
+    Serial.println("};");
+  }
+
+  void showResults() {
+    char msg[32];
+    uint32_t replayed = ticks - replayTicks;
+    uint32_t time = replayTime ? replayTime : 1;
+
+    engine.display.clear();
+    snprintf(msg, sizeof(msg), "recorded: %d, %d", recordedX, recordedY);
+    engine.display.drawText(5, 10, msg);
+    snprintf(msg, sizeof(msg), "replayed: %d, %d", x, y);
+    engine.display.drawText(5, 25, msg);
+    engine.display.drawText(5, 40, x == recordedX && y == recordedY ? "MATCH" : "MISMATCH");
+    snprintf(msg, sizeof(msg), "ticks/s: %lu", (unsigned long)(replayed * 1000 / time));
+    engine.display.drawText(5, 55, msg);
+    snprintf(msg, sizeof(msg), "updates/s: %lu", (unsigned long)(replayUpdates * 1000 / time));
+    engine.display.drawText(5, 70, msg);
+    snprintf(msg, sizeof(msg), "log: %u bytes", recordingLength);
+    engine.display.drawText(5, 85, msg);
+    engine.display.update();
+  }
+} dot;
+
+void setup() {
+  engine.start(Kywy::EngineOptions().cooperativeScheduler(true).buttonEvents(false));
+
+  dot.subscribe(&engine.clock);
+  dot.subscribe(&engine.input, ::Actor::signalMask(Kywy::Events::INPUT_STATE) | ::Actor::signalMask(Kywy::Events::REPLAY_FINISHED));
+  dot.start();
+
+  engine.input.startRecording(recording, sizeof(recording));
+}
+
+void loop() {
+  delay(1000);
+}
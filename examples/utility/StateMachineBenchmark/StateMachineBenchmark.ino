@@ -0,0 +1,217 @@
+// SPDX-FileCopyrightText: 2025 KOINSLOT, Inc.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// Times transitions across a 6 level state hierarchy
+//
+// Notes:
+//   - a state machine asks each state for its parent once and remembers it,
+//     and remembers the path of the transitions it has taken recently
+//   - so after the first few transitions no state is asked for its parent
+//     again, and a transition only calls the states it exits and enters
+//   - a `StateTable` declares the same hierarchy in constexpr tables, so
+//     nothing is asked for at runtime and states are handled with a switch
+//
+// This example:
+//   - bounces between the deepest states of two 6 level branches, which
+//     exits 5 states and enters 5 states every transition
+//   - also sends an event from the deepest state that is only handled by the
+//     root, so it passes through all 6 states
+//   - shows the average time per transition and per event for both kinds of
+//     state machine, events per second, and how many times a state was asked
+//     for its parent
+
+#include "Kywy.hpp"
+#include "StateMachine.hpp"
+#include "StateTable.hpp"
+
+#define ROUNDS 1000
+
+Kywy::Engine engine;
+
+using namespace StateMachine;
+
+typedef enum : uint16_t {
+  EVENT_SWAP = EVENT_USER,
+  EVENT_PING,
+} BenchmarkSignal;
+
+uint32_t parentRequests = 0;
+
+class Hierarchy : public StateMachine::StateMachine {
+public:
+  void setup() {
+    initialize(static_cast<State>(&Hierarchy::a5));
+  }
+
+  // root > a1 > a2 > a3 > a4 > a5 and root > b1 > b2 > b3 > b4 > b5
+  Result root(Event event) {
+    switch (event.signal) {
+      case EVENT_SWAP:
+        return transitionTo(inA ? static_cast<State>(&Hierarchy::b5) : static_cast<State>(&Hierarchy::a5));
+      case EVENT_PING:
+        return Result{ .type = RESULT_HANDLED };
+    }
+    return common(event, nullptr);
+  }
+  Result a1(Event event) {
+    return common(event, static_cast<State>(&Hierarchy::root));
+  }
+  Result a2(Event event) {
+    return common(event, static_cast<State>(&Hierarchy::a1));
+  }
+  Result a3(Event event) {
+    return common(event, static_cast<State>(&Hierarchy::a2));
+  }
+  Result a4(Event event) {
+    return common(event, static_cast<State>(&Hierarchy::a3));
+  }
+  Result a5(Event event) {
+    if (event.signal == EVENT_ENTER) {
+      inA = true;
+    }
+    return common(event, static_cast<State>(&Hierarchy::a4));
+  }
+  Result b1(Event event) {
+    return common(event, static_cast<State>(&Hierarchy::root));
+  }
+  Result b2(Event event) {
+    return common(event, static_cast<State>(&Hierarchy::b1));
+  }
+  Result b3(Event event) {
+    return common(event, static_cast<State>(&Hierarchy::b2));
+  }
+  Result b4(Event event) {
+    return common(event, static_cast<State>(&Hierarchy::b3));
+  }
+  Result b5(Event event) {
+    if (event.signal == EVENT_ENTER) {
+      inA = false;
+    }
+    return common(event, static_cast<State>(&Hierarchy::b4));
+  }
+
+private:
+  bool inA = false;
+
+  Result transitionTo(State target) {
+    return Result{ .type = RESULT_TRANSITION, .target = target };
+  }
+
+  Result common(Event event, State parent) {
+    switch (event.signal) {
+      case EVENT_REQUEST_PARENT:
+        parentRequests++;
+        return Result{ .type = RESULT_PARENT, .target = parent };
+      case EVENT_REQUEST_CHILD:
+        return Result{ .type = RESULT_CHILD, .target = nullptr };
+      case EVENT_ENTER:
+      case EVENT_EXIT:
+        return Result{ .type = RESULT_HANDLED };
+    }
+    return Result{ .type = RESULT_UNHANDLED };
+  }
+} hierarchy;
+
+// the same hierarchy as a table
+enum : uint8_t { ROOT, A1, A2, A3, A4, A5, B1, B2, B3, B4, B5, STATE_COUNT };
+
+constexpr StateDeclaration tableStates[STATE_COUNT] = {
+  /* ROOT */ { NO_STATE, NO_STATE },
+  /* A1   */ { ROOT, NO_STATE },
+  /* A2   */ { A1, NO_STATE },
+  /* A3   */ { A2, NO_STATE },
+  /* A4   */ { A3, NO_STATE },
+  /* A5   */ { A4, NO_STATE },
+  /* B1   */ { ROOT, NO_STATE },
+  /* B2   */ { B1, NO_STATE },
+  /* B3   */ { B2, NO_STATE },
+  /* B4   */ { B3, NO_STATE },
+  /* B5   */ { B4, NO_STATE },
+};
+
+constexpr TransitionDeclaration tableTransitions[] = {
+  { A5, EVENT_SWAP, B5 },
+  { B5, EVENT_SWAP, A5 },
+};
+
+class TableHierarchy : public StateTable<TableHierarchy, tableStates, STATE_COUNT, tableTransitions,
+                                         sizeof(tableTransitions) / sizeof(tableTransitions[0])> {
+public:
+  uint32_t entered = 0;
+
+  void enter(uint8_t state) {
+    entered++;
+  }
+
+  ResultType react(uint8_t state, Event event) {
+    switch (state) {
+      case ROOT:
+        return event.signal == EVENT_PING ? RESULT_HANDLED : RESULT_UNHANDLED;
+      default:
+        return RESULT_UNHANDLED;
+    }
+  }
+} tableHierarchy;
+
+uint32_t timeEvents(uint16_t signal, bool table) {
+  uint32_t start = micros();
+  for (int i = 0; i < ROUNDS; i++) {
+    if (table) {
+      tableHierarchy.handle(Event{ .signal = signal });
+    } else {
+      hierarchy.handle(Event{ .signal = signal });
+    }
+  }
+  return micros() - start;
+}
+
+class Benchmark : public Actor::Actor {
+public:
+  void handle(::Actor::Message *message) {
+    switch (message->signal) {
+      case Kywy::Events::TICK:
+        {
+          uint32_t transitionTime = timeEvents(EVENT_SWAP, false);
+          uint32_t eventTime = timeEvents(EVENT_PING, false);
+          uint32_t tableTransitionTime = timeEvents(EVENT_SWAP, true);
+          uint32_t tableEventTime = timeEvents(EVENT_PING, true);
+
+          char msg[32];
+          engine.display.clear();
+
+          engine.display.drawText(5, 10, "6 level hierarchy");
+          engine.display.drawText(5, 25, "StateMachine");
+          snprintf(msg, sizeof(msg), "transition: %luns", (unsigned long)(transitionTime * 1000 / ROUNDS));
+          engine.display.drawText(5, 40, msg);
+          snprintf(msg, sizeof(msg), "event to root: %luns", (unsigned long)(eventTime * 1000 / ROUNDS));
+          engine.display.drawText(5, 55, msg);
+          snprintf(msg, sizeof(msg), "events/s: %lu", (unsigned long)(ROUNDS * 1000000ull / (eventTime ? eventTime : 1)));
+          engine.display.drawText(5, 70, msg);
+          snprintf(msg, sizeof(msg), "parent requests: %lu", (unsigned long)parentRequests);
+          engine.display.drawText(5, 85, msg);
+
+          engine.display.drawText(5, 105, "StateTable");
+          snprintf(msg, sizeof(msg), "transition: %luns", (unsigned long)(tableTransitionTime * 1000 / ROUNDS));
+          engine.display.drawText(5, 120, msg);
+          snprintf(msg, sizeof(msg), "event to root: %luns", (unsigned long)(tableEventTime * 1000 / ROUNDS));
+          engine.display.drawText(5, 135, msg);
+          snprintf(msg, sizeof(msg), "events/s: %lu", (unsigned long)(ROUNDS * 1000000ull / (tableEventTime ? tableEventTime : 1)));
+          engine.display.drawText(5, 150, msg);
+
+          engine.display.update();
+          break;
+        }
+    }
+  }
+} benchmark;
+
+void setup() {
+  engine.start();
+
+  hierarchy.setup();
+  tableHierarchy.initialize(A5);
+
+  benchmark.subscribe(&engine.clock);
+  benchmark.start();
+}
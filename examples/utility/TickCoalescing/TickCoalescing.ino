@@ -0,0 +1,208 @@
+// SPDX-FileCopyrightText: 2025 KOINSLOT, Inc.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// Checks that slow actors can't back up the message queue with ticks
+//
+// Notes:
+//   - by default TICKs coalesce, an actor still busy with one doesn't get the
+//     ones published in the meantime, it sees a gap in `Tick::frame` and each
+//     dropped tick is counted by `getCoalesced`
+//   - with a fixed timestep every tick is delivered, including the catch-up
+//     ticks published back to back when the clock fell behind, so handlers
+//     only have to keep up on average
+//   - other messages, like input, are never dropped for being stale
+//   - extras/host/tests/TickCoalescingTest.cpp checks the same with fake
+//     time on a PC, this sketch checks it with real threads and timing
+//
+// This example:
+//   - runs on the cooperative scheduler, where every actor shares one thread,
+//     so one slow handler holds up everyone
+//   - the first worker is slower than the clock on every tick (every tenth
+//     tick with a fixed timestep), the second stalls the whole chip with
+//     interrupts off every tenth tick so the clock falls behind and has to
+//     catch up
+//   - a thread presses a numbered fake button every tick duration, which both
+//     workers have to receive in full
+//   - once the workers go idle and their queues drain, the checker prints the
+//     results to the screen and the Serial Monitor, and fails if the
+//     scheduler queue got deeper than QUEUE_BOUND, a message was dropped, or
+//     a tick went missing without being counted as coalesced
+//   - set FIXED_TIMESTEP to true to check the fixed timestep clock
+
+#include "Kywy.hpp"
+
+#define FIXED_TIMESTEP false
+
+#define TEST_TICKS 300   // ticks the workers are slow for
+#define DRAIN_TICKS 30   // ticks to wait afterwards for queues to drain
+#define PRESSES 300      // one per tick duration
+#define QUEUE_BOUND 32   // half of SCHEDULER_QUEUE_SIZE
+
+#if FIXED_TIMESTEP
+#define BUSY_EVERY 10  // has to keep up on average
+#else
+#define BUSY_EVERY 1  // always behind, stale ticks are dropped
+#endif
+#define BUSY_TICKS 3       // how long the first worker works for, in tick durations
+#define STALL_EVERY 10
+#define STALL_TICKS 3.5f  // how long the second worker stalls for
+
+Kywy::Engine engine;
+
+enum {
+  PRESS = Kywy::Events::USER_EVENTS,
+};
+
+class Worker : public Actor::Actor {
+public:
+  bool stalls = false;
+
+  uint32_t handled = 0;
+  uint32_t nextFrame = 0;
+  uint32_t missed = 0;  // ticks that never arrived
+
+  uint32_t presses = 0;
+  uint32_t lostPresses = 0;
+
+  void handle(::Actor::Message *message) {
+    switch (message->signal) {
+      case Kywy::Events::TICK:
+        {
+          Kywy::Tick tick = message->getPayload<Kywy::Tick>();
+          if (handled++) {
+            missed += tick.frame - nextFrame;
+          }
+          nextFrame = tick.frame + 1;
+
+          if (tick.frame >= TEST_TICKS) {
+            break;  // idle so the queues drain
+          }
+
+          // the stalls land halfway between the first worker's busy ticks
+          uint32_t duration = engine.clock.getTickDuration() * 1000;
+          if (stalls && handled % STALL_EVERY == STALL_EVERY / 2) {
+            // the clock thread can't run either, so it falls behind
+            core_util_critical_section_enter();
+            busyWait((uint32_t)(duration * STALL_TICKS));
+            core_util_critical_section_exit();
+          } else if (!stalls && handled % BUSY_EVERY == 0) {
+            busyWait(duration * BUSY_TICKS);
+          }
+          break;
+        }
+      case PRESS:
+        {
+          uint32_t press = message->getPayload<uint32_t>();
+          lostPresses += press - presses;
+          presses = press + 1;
+          break;
+        }
+    }
+  }
+
+private:
+  void busyWait(uint32_t microseconds) {
+    uint32_t start = micros();
+    while (micros() - start < microseconds)
+      ;
+  }
+} workers[2];
+
+// publishes from its own thread, it's never started
+class Presser : public Actor::Actor {
+public:
+  uint32_t sent = 0;
+
+  void handle(::Actor::Message *) {}
+
+  void run() {
+    for (; sent < PRESSES; sent++) {
+      ::Actor::Message message(PRESS);
+      message.setPayload(sent);
+      publish(message);
+      rtos::ThisThread::sleep_for(std::chrono::milliseconds(engine.clock.getTickDuration()));
+    }
+  }
+} presser;
+
+rtos::Thread presserThread;
+
+class Checker : public Actor::Actor {
+public:
+  bool reported = false;
+
+  void handle(::Actor::Message *message) {
+    if (message->signal != Kywy::Events::TICK || reported) {
+      return;
+    }
+
+    if (message->getPayload<Kywy::Tick>().frame < TEST_TICKS + DRAIN_TICKS || presser.sent < PRESSES) {
+      return;
+    }
+
+    bool passed = ::Actor::scheduler.getHighWater() <= QUEUE_BOUND
+                  && ::Actor::scheduler.getDropped() == 0
+                  && ::Actor::messagePool.getExhausted() == 0;
+
+    uint32_t missed = 0, coalesced = 0, presses = 0;
+    for (uint8_t i = 0; i < 2; i++) {
+      // every gap has to be a tick that was dropped on purpose
+      passed = passed && workers[i].missed == workers[i].getCoalesced();
+      passed = passed && workers[i].presses == PRESSES && workers[i].lostPresses == 0;
+      missed += workers[i].missed;
+      coalesced += workers[i].getCoalesced();
+      presses += workers[i].presses - workers[i].lostPresses;
+    }
+    passed = passed && (!FIXED_TIMESTEP || missed == 0);
+
+    char msg[32];
+    engine.display.clear();
+
+    engine.display.drawText(5, 10, FIXED_TIMESTEP ? "mode: fixed timestep" : "mode: coalescing");
+    snprintf(msg, sizeof(msg), "queue high water: %u", (unsigned)::Actor::scheduler.getHighWater());
+    engine.display.drawText(5, 25, msg);
+    snprintf(msg, sizeof(msg), "missed ticks: %lu", (unsigned long)missed);
+    engine.display.drawText(5, 40, msg);
+    snprintf(msg, sizeof(msg), "coalesced: %lu", (unsigned long)coalesced);
+    engine.display.drawText(5, 55, msg);
+    snprintf(msg, sizeof(msg), "presses: %lu/%lu", (unsigned long)presses, (unsigned long)2 * PRESSES);
+    engine.display.drawText(5, 70, msg);
+    snprintf(msg, sizeof(msg), "clock skipped: %lu", (unsigned long)engine.clock.stats.skipped);
+    engine.display.drawText(5, 85, msg);
+    engine.display.drawText(5, 105, passed ? "PASSED" : "FAILED");
+
+    engine.display.update();
+
+    char report[160];
+    snprintf(report, sizeof(report), "%s, queue high water: %u, dropped: %lu, missed ticks: %lu, coalesced: %lu, presses: %lu/%lu, clock skipped: %lu",
+             passed ? "PASSED" : "FAILED",
+             (unsigned)::Actor::scheduler.getHighWater(),
+             (unsigned long)::Actor::scheduler.getDropped(),
+             (unsigned long)missed, (unsigned long)coalesced,
+             (unsigned long)presses, (unsigned long)2 * PRESSES,
+             (unsigned long)engine.clock.stats.skipped);
+    Serial.println(report);
+    reported = true;
+  }
+} checker;
+
+void setup() {
+  engine.start(Kywy::EngineOptions().cooperativeScheduler(true).fixedTimestep(FIXED_TIMESTEP));
+
+  workers[1].stalls = true;
+  for (uint8_t i = 0; i < 2; i++) {
+    workers[i].subscribe(&engine.clock);
+    workers[i].subscribe(&presser);
+    workers[i].start();
+  }
+
+  checker.subscribe(&engine.clock);
+  checker.start();
+
+  presserThread.start(mbed::callback(&presser, &Presser::run));
+}
+
+void loop() {
+  delay(1000);
+}
@@ -0,0 +1,60 @@
+// SPDX-FileCopyrightText: 2025 KOINSLOT, Inc.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// Pixels per microsecond of the row blit kernels against the byte-at-a-time
+// kernel they replaced (see tests/BlitReference.hpp), for 16x16 sprites on and
+// off byte boundaries and for 90x60 solid fills. tests/BlitTest.cpp checks
+// that both write the same pixels.
+
+#include <chrono>
+
+#include "../tests/BlitReference.hpp"
+
+#define RUNS 200000
+
+static Display::Driver::MBED_SPI_DRIVER driver;
+static uint8_t reference[REFERENCE_BUFFER_SIZE];
+static uint8_t sprite[16 * 16 / 8 + 1];
+
+// runs `blit(run)` RUNS times and prints how fast `pixels` per run went
+template<typename Blit>
+static void measure(const char *name, uint32_t pixels, Blit blit) {
+  auto start = std::chrono::steady_clock::now();
+  for (uint32_t run = 0; run < RUNS; run++) {
+    blit(run);
+  }
+  double microseconds = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+  printf("  %-28s %7.1f px/us\n", name, (double)pixels * RUNS / microseconds);
+}
+
+int main() {
+  for (uint8_t &byte : sprite) {
+    byte = rand();
+  }
+  Display::BitmapOptions options;
+
+  // every x from 1 to 120 lands off a byte boundary 7 times in 8
+  measure("old 16x16 sprite unaligned", 256, [&](uint32_t run) {
+    referenceBlit(reference, run % 120 + 1, run % 140, 16, 16, sprite, options, false, 0x00);
+  });
+  measure("new 16x16 sprite unaligned", 256, [&](uint32_t run) {
+    driver.writeBitmapToBuffer(run % 120 + 1, run % 140, 16, 16, sprite, options);
+  });
+
+  measure("old 16x16 sprite aligned", 256, [&](uint32_t run) {
+    referenceBlit(reference, run % 16 * 8, run % 140, 16, 16, sprite, options, false, 0x00);
+  });
+  measure("new 16x16 sprite aligned", 256, [&](uint32_t run) {
+    driver.writeBitmapToBuffer(run % 16 * 8, run % 140, 16, 16, sprite, options);
+  });
+
+  measure("old 90x60 fill", 90 * 60, [&](uint32_t run) {
+    referenceBlit(reference, run % 50, 10, 90, 60, nullptr, Display::BitmapOptions().opaque(true), true, 0x00);
+  });
+  measure("new 90x60 fill", 90 * 60, [&](uint32_t run) {
+    driver.setBufferBlock(run % 50, 10, 90, 60, 0x00);
+  });
+
+  return 0;
+}
@@ -0,0 +1,60 @@
+// SPDX-FileCopyrightText: 2025 KOINSLOT, Inc.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// Nanoseconds per `Font::getCharacter` in intel_one_mono_8_pt (the default
+// font) against the walk it replaced (see tests/GlyphReference.hpp), for
+// letters and digits, which are found straight from the ASCII table, and for
+// Vietnamese letters near the end of the font, which are found through the
+// checkpoints. tests/GlyphLookupTest.cpp
+// checks that both find the same glyphs.
+
+#include <chrono>
+
+#include "../tests/GlyphReference.hpp"
+#include "Fonts.hpp"
+
+#define RUNS 20000
+
+// runs `lookup` RUNS times on every one of `characters` and prints the time
+// per lookup
+template<typename Lookup>
+static void measure(const char *name, const uint16_t *characters, uint16_t count, Lookup lookup) {
+  volatile uintptr_t sink = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (uint32_t run = 0; run < RUNS; run++) {
+    for (uint16_t i = 0; i < count; i++) {
+      sink = sink + (uintptr_t)lookup(characters[i]);
+    }
+  }
+  double nanoseconds = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+  printf("  %-22s %6.1f ns/lookup\n", name, nanoseconds / RUNS / count);
+}
+
+int main() {
+  Display::Font::Font font(Display::Font::intel_one_mono_8_pt);
+
+  uint16_t alphanumerics[62], vietnamese[48];
+  const char *alphabet = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789";
+  for (uint16_t i = 0; i < 62; i++) {
+    alphanumerics[i] = alphabet[i];
+  }
+  for (uint16_t i = 0; i < 48; i++) {
+    vietnamese[i] = 0x1ea0 + i;
+  }
+
+  measure("old alphanumerics", alphanumerics, 62, [&](uint16_t c) {
+    return referenceLookup(font, c);
+  });
+  measure("new alphanumerics", alphanumerics, 62, [&](uint16_t c) {
+    return font.getCharacter(c).bitmap;
+  });
+  measure("old vietnamese", vietnamese, 48, [&](uint16_t c) {
+    return referenceLookup(font, c);
+  });
+  measure("new vietnamese", vietnamese, 48, [&](uint16_t c) {
+    return font.getCharacter(c).bitmap;
+  });
+
+  return 0;
+}
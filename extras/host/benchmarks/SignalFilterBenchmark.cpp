@@ -0,0 +1,142 @@
+// SPDX-FileCopyrightText: 2025 KOINSLOT, Inc.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// How many input messages are queued and handled over 5 minutes of play at 30
+// ticks a second when actors subscribe to every input signal, and when they
+// subscribe to just the signals they use (`::Actor::signalMask`). Eight actors
+// take the clock, six of them also want 1-4 input signals, and every tick each
+// button changes with a 4% chance.
+
+#include <chrono>
+#include <random>
+
+#include "Actor.hpp"
+#include "Events.hpp"
+
+#define TICKS (30 * 60 * 5)
+#define ACTORS 8
+
+using namespace Kywy::Events;
+
+class Sink : public Actor::Actor {
+public:
+  uint32_t inputs = 0;
+
+  void handle(::Actor::Message *message) {
+    if (message->signal != TICK) {
+      inputs++;
+    }
+  };
+};
+
+class Publisher : public Actor::Actor {
+public:
+  uint32_t published = 0;
+
+  void send(int signal) {
+    published++;
+    publish(::Actor::Message(signal));
+  };
+  void handle(::Actor::Message *) {}
+};
+
+// what each actor handles, -1 ends the list
+static const int wanted[ACTORS][4] = {
+  { D_PAD_LEFT_PRESSED, D_PAD_LEFT_RELEASED, D_PAD_RIGHT_PRESSED, D_PAD_RIGHT_RELEASED },
+  { BUTTON_LEFT_PRESSED, -1 },
+  { D_PAD_CENTER_PRESSED, -1 },
+  { D_PAD_UP_PRESSED, D_PAD_DOWN_PRESSED, -1 },
+  { INPUT_PRESSED, -1 },
+  { BUTTON_RIGHT_PRESSED, -1 },
+  { -1 },
+  { -1 },
+};
+
+// pressed and released, in `Kywy::Button` order
+static const int buttonSignals[7][2] = {
+  { BUTTON_LEFT_PRESSED, BUTTON_LEFT_RELEASED },
+  { BUTTON_RIGHT_PRESSED, BUTTON_RIGHT_RELEASED },
+  { D_PAD_LEFT_PRESSED, D_PAD_LEFT_RELEASED },
+  { D_PAD_RIGHT_PRESSED, D_PAD_RIGHT_RELEASED },
+  { D_PAD_UP_PRESSED, D_PAD_UP_RELEASED },
+  { D_PAD_DOWN_PRESSED, D_PAD_DOWN_RELEASED },
+  { D_PAD_CENTER_PRESSED, D_PAD_CENTER_RELEASED },
+};
+
+static void run(bool filtered) {
+  Publisher clock, input;
+  Sink actors[ACTORS];
+
+  for (uint8_t i = 0; i < ACTORS; i++) {
+    actors[i].subscribe(&clock);
+    if (wanted[i][0] < 0) {
+      continue;
+    }
+
+    if (!filtered) {
+      actors[i].subscribe(&input);
+      continue;
+    }
+    for (uint8_t j = 0; j < 4 && wanted[i][j] >= 0; j++) {
+      actors[i].subscribe(&input, ::Actor::signalMask(wanted[i][j]));
+    }
+  }
+
+  std::mt19937 generator(1);
+  bool held[7] = {};
+  ::Actor::dispatchStats = ::Actor::DispatchStats();
+
+  auto start = std::chrono::steady_clock::now();
+  for (uint32_t tick = 0; tick < TICKS; tick++) {
+    clock.send(TICK);
+
+    // the same messages the input actor publishes
+    bool any = false, anyPressed = false, dPad = false, dPadPressed = false;
+    for (uint8_t button = 0; button < 7; button++) {
+      if (generator() % 100 >= 4) {
+        continue;
+      }
+      held[button] = !held[button];
+      input.send(buttonSignals[button][held[button] ? 0 : 1]);
+      any = true;
+      anyPressed |= held[button];
+      dPad |= button >= 2;
+      dPadPressed |= button >= 2 && held[button];
+    }
+    if (any)
+      input.send(Kywy::Events::INPUT);
+    if (anyPressed)
+      input.send(INPUT_PRESSED);
+    if (dPad)
+      input.send(D_PAD);
+    if (dPadPressed)
+      input.send(D_PAD_PRESSED);
+
+    while (::Actor::scheduler.runOnce())
+      ;
+  }
+  double milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+  uint32_t handled = 0;
+  for (Sink &actor : actors) {
+    handled += actor.inputs;
+  }
+  printf("  %-10s %lu input messages, %6lu handled, %6lu filtered out, %.1fms\n",
+         filtered ? "filtered" : "everything", (unsigned long)input.published,
+         (unsigned long)handled, (unsigned long)::Actor::dispatchStats.messagesFiltered,
+         milliseconds);
+}
+
+int main() {
+  ::Actor::setSchedulerMode(::Actor::SCHEDULER_COOPERATIVE);
+
+  run(false);
+  run(true);
+
+  printf("  message pool high water %u, exhausted %lu, scheduler dropped %lu\n",
+         (unsigned)::Actor::messagePool.getHighWater(),
+         (unsigned long)::Actor::messagePool.getExhausted(),
+         (unsigned long)::Actor::scheduler.getDropped());
+  return 0;
+}
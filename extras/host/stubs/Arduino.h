@@ -0,0 +1,96 @@
+// SPDX-FileCopyrightText: 2025 KOINSLOT, Inc.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// Just enough of the Arduino core to build the library on a PC, see
+// extras/host/README.md
+
+#ifndef KYWY_HOST_ARDUINO
+#define KYWY_HOST_ARDUINO 1
+
+#include <math.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <string>
+
+#include "mbed.h"
+
+enum PinStatus { LOW = 0,
+                 HIGH = 1,
+                 CHANGE = 2,
+                 FALLING = 3,
+                 RISING = 4 };
+enum PinMode { INPUT = 0,
+               OUTPUT = 1,
+               INPUT_PULLUP = 2 };
+
+void pinMode(int pin, int mode);
+void digitalWrite(int pin, int level);
+int digitalRead(int pin);
+int analogRead(int pin);
+
+// an interrupt attached to a pin fires from `host::setPin` when the level
+// changes
+int digitalPinToInterrupt(int pin);
+void attachInterrupt(int interrupt, void (*callback)(), PinStatus mode);
+void detachInterrupt(int interrupt);
+
+unsigned long micros();
+unsigned long millis();
+void delay(unsigned long milliseconds);
+
+class String {
+public:
+  String() {}
+  String(const char *) {}
+  String(int) {}
+};
+
+class Print {
+public:
+  virtual size_t write(uint8_t c) = 0;
+  virtual size_t write(const uint8_t *buffer, size_t size) {
+    for (size_t i = 0; i < size; i++) {
+      write(buffer[i]);
+    }
+    return size;
+  };
+};
+
+// keeps whatever is written in `output` and reads from `input`
+class HardwareSerial : public Print {
+public:
+  std::string input, output;
+
+  void begin(unsigned long) {}
+  int available() {
+    return input.size();
+  };
+  int read();
+  size_t write(uint8_t c);
+  size_t write(const uint8_t *buffer, size_t size);
+  size_t println(const char *text);
+  size_t println(const String &) {
+    return 0;
+  };
+  size_t println();
+};
+
+extern HardwareSerial Serial;
+
+namespace host {
+
+// micros() and millis() follow the PC's clock until a test sets the time,
+// then only move when the test moves them
+void setMicros(uint32_t micros);
+void advanceMicros(uint32_t micros);
+void useRealTime();
+
+// what digitalRead returns, pins start high like the buttons' pull-ups
+void setPin(int pin, int level);
+
+}  // namespace host
+
+#endif
@@ -0,0 +1,54 @@
+// SPDX-FileCopyrightText: 2025 KOINSLOT, Inc.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// Event queues that drop their events, see mbed.h
+
+#ifndef KYWY_HOST_EVENT_QUEUE
+#define KYWY_HOST_EVENT_QUEUE 1
+
+#include <stdint.h>
+
+#include <chrono>
+
+#define EVENTS_EVENT_SIZE 64
+#define EVENTS_QUEUE_SIZE (32 * EVENTS_EVENT_SIZE)
+
+namespace events {
+
+class EventQueue {
+public:
+  EventQueue(unsigned = EVENTS_QUEUE_SIZE, unsigned char * = nullptr) {}
+  void dispatch_forever() {}
+  void dispatch_once() {}
+  void dispatch(int = -1) {}
+  void break_dispatch() {}
+  bool cancel(int) {
+    return true;
+  };
+  template<typename F, typename... A> int call(F, A...) {
+    return 1;
+  };
+  template<typename D, typename F> int call_every(D, F) {
+    return 1;
+  };
+  template<typename D, typename F> int call_in(D, F) {
+    return 1;
+  };
+};
+
+template<typename F> class Event;
+template<typename... A> class Event<void(A...)> {
+public:
+  Event(EventQueue *, void (*)(A...)) {}
+  template<typename D> void delay(D) {}
+  template<typename D> void period(D) {}
+  int post(A...) {
+    return 1;
+  };
+  void cancel() {}
+};
+
+}  // namespace events
+
+#endif
@@ -0,0 +1,116 @@
+// SPDX-FileCopyrightText: 2025 KOINSLOT, Inc.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "Arduino.h"
+
+HardwareSerial Serial;
+
+static bool realTime = true;
+static uint32_t fakeMicros = 0;
+
+static int pinLevels[64];
+static bool pinsSet = false;
+static void (*pinInterrupts[64])() = {};
+
+void host::setMicros(uint32_t micros) {
+  realTime = false;
+  fakeMicros = micros;
+}
+
+void host::advanceMicros(uint32_t micros) {
+  realTime = false;
+  fakeMicros += micros;
+}
+
+void host::useRealTime() {
+  realTime = true;
+}
+
+unsigned long micros() {
+  if (!realTime) {
+    return fakeMicros;
+  }
+  return (uint32_t)std::chrono::duration_cast<std::chrono::microseconds>(
+           std::chrono::steady_clock::now().time_since_epoch())
+    .count();
+}
+
+unsigned long millis() {
+  return micros() / 1000;
+}
+
+void delay(unsigned long milliseconds) {
+  if (!realTime) {
+    fakeMicros += milliseconds * 1000;
+  }
+}
+
+static int &pinLevel(int pin) {
+  if (!pinsSet) {
+    for (int &level : pinLevels) {
+      level = HIGH;
+    }
+    pinsSet = true;
+  }
+  return pinLevels[pin & 63];
+}
+
+void host::setPin(int pin, int level) {
+  bool changed = pinLevel(pin) != level;
+  pinLevel(pin) = level;
+  if (changed && pinInterrupts[pin & 63]) {
+    pinInterrupts[pin & 63]();
+  }
+}
+
+void pinMode(int, int) {}
+void digitalWrite(int pin, int level) {
+  pinLevel(pin) = level;
+}
+int digitalRead(int pin) {
+  return pinLevel(pin);
+}
+int analogRead(int) {
+  return 0;
+}
+
+int digitalPinToInterrupt(int pin) {
+  return pin;
+}
+void attachInterrupt(int interrupt, void (*callback)(), PinStatus) {
+  pinInterrupts[interrupt & 63] = callback;
+}
+void detachInterrupt(int interrupt) {
+  pinInterrupts[interrupt & 63] = nullptr;
+}
+
+int HardwareSerial::read() {
+  if (input.empty()) {
+    return -1;
+  }
+  int c = (unsigned char)input[0];
+  input.erase(0, 1);
+  return c;
+}
+
+size_t HardwareSerial::write(uint8_t c) {
+  output += (char)c;
+  return 1;
+}
+
+size_t HardwareSerial::write(const uint8_t *buffer, size_t size) {
+  output.append((const char *)buffer, size);
+  return size;
+}
+
+size_t HardwareSerial::println(const char *text) {
+  output += text;
+  output += "\n";
+  return strlen(text) + 1;
+}
+
+size_t HardwareSerial::println() {
+  output += "\n";
+  return 1;
+}
@@ -0,0 +1,5 @@
+// SPDX-FileCopyrightText: 2025 KOINSLOT, Inc.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// the library only needs mbed::SPI from this, see mbed.h
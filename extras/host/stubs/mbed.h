@@ -0,0 +1,173 @@
+// SPDX-FileCopyrightText: 2025 KOINSLOT, Inc.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// Just enough of mbed OS to build the library on a PC, see
+// extras/host/README.md. There is only one thread: threads never start,
+// mutexes and critical sections do nothing and event queues drop their
+// events, so tests run actors with the cooperative scheduler and call the
+// clock's callbacks themselves.
+
+#ifndef KYWY_HOST_MBED
+#define KYWY_HOST_MBED 1
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <chrono>
+#include <functional>
+
+typedef int PinName;
+enum DMAUsage { DMA_USAGE_NEVER,
+                DMA_USAGE_OPPORTUNISTIC };
+
+namespace mbed {
+
+template<typename F> class Callback;
+template<typename R, typename... A> class Callback<R(A...)> {
+public:
+  Callback() {}
+  template<typename F> Callback(F f)
+    : function(f) {}
+
+  R operator()(A... arguments) const {
+    return function(arguments...);
+  };
+  explicit operator bool() const {
+    return (bool)function;
+  };
+
+private:
+  std::function<R(A...)> function;
+};
+
+template<typename R, typename... A>
+Callback<R(A...)> callback(R (*function)(A...)) {
+  return Callback<R(A...)>(function);
+}
+
+template<typename R, typename T, typename... A>
+Callback<R(A...)> callback(R (*function)(T *, A...), T *argument) {
+  return Callback<R(A...)>([=](A... arguments) {
+    return function(argument, arguments...);
+  });
+}
+
+template<typename R, typename T, typename U, typename... A>
+Callback<R(A...)> callback(U *object, R (T::*method)(A...)) {
+  return Callback<R(A...)>([=](A... arguments) {
+    return (object->*method)(arguments...);
+  });
+}
+
+typedef Callback<void(int)> event_callback_t;
+
+#define SPI_EVENT_COMPLETE 1
+#define SPI_EVENT_ALL 0xf
+
+// writes go nowhere, transfers complete right away
+class SPI {
+public:
+  SPI(PinName, PinName, PinName) {}
+  void format(int, int = 0) {}
+  void frequency(int) {}
+  int write(int) {
+    return 0;
+  };
+  int write(const char *, int, char *, int) {
+    return 0;
+  };
+  template<typename T>
+  int transfer(const T *, int, T *, int, const event_callback_t &callback, int = SPI_EVENT_COMPLETE) {
+    callback(SPI_EVENT_COMPLETE);
+    return 0;
+  };
+  void set_dma_usage(DMAUsage) {}
+  void lock() {}
+  void unlock() {}
+};
+
+class Ticker {
+public:
+  void attach(Callback<void()>, std::chrono::microseconds) {}
+  void detach() {}
+};
+
+}  // namespace mbed
+
+#define OS_STACK_SIZE 4096
+
+inline void core_util_critical_section_enter() {}
+inline void core_util_critical_section_exit() {}
+
+inline uint32_t core_util_atomic_incr_u32(volatile uint32_t *value, uint32_t delta) {
+  return *value += delta;
+}
+inline uint16_t core_util_atomic_incr_u16(volatile uint16_t *value, uint16_t delta) {
+  return *value += delta;
+}
+inline uint16_t core_util_atomic_decr_u16(volatile uint16_t *value, uint16_t delta) {
+  return *value -= delta;
+}
+
+namespace rtos {
+
+enum { osPriorityLow = -1,
+       osPriorityBelowNormal = -2,
+       osPriorityNormal = 0,
+       osPriorityAboveNormal = 1 };
+
+class Mutex {
+public:
+  void lock() {}
+  void unlock() {}
+  bool trylock() {
+    return true;
+  };
+};
+
+class Semaphore {
+public:
+  Semaphore(int = 0, int = 1) {}
+  void acquire() {}
+  bool try_acquire() {
+    return true;
+  };
+  void release() {}
+};
+
+class EventFlags {
+public:
+  uint32_t set(uint32_t flags) {
+    return flags;
+  };
+  uint32_t clear(uint32_t flags = 0x7fffffff) {
+    return flags;
+  };
+  uint32_t wait_any(uint32_t flags, uint32_t = 0xffffffff, bool = true) {
+    return flags;
+  };
+};
+
+class Thread {
+public:
+  Thread(int = osPriorityNormal, uint32_t = OS_STACK_SIZE, unsigned char * = nullptr, const char * = nullptr) {}
+  int start(mbed::Callback<void()>) {
+    return 0;
+  };
+};
+
+namespace ThisThread {
+inline void sleep_for(std::chrono::milliseconds) {}
+inline void yield() {}
+}  // namespace ThisThread
+
+}  // namespace rtos
+
+#include "EventQueue.h"
+
+using namespace std::chrono_literals;
+
+#endif
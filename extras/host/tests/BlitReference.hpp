@@ -0,0 +1,169 @@
+// SPDX-FileCopyrightText: 2023 - 2025 KOINSLOT, Inc.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// The byte-at-a-time blit kernel `MBED_SPI_DRIVER::writeBitmapOrBlockToBuffer`
+// used before the row kernels, kept as the reference they are checked and
+// measured against. It writes to an unrotated 144x168 buffer and only crops to
+// the screen, callers handle the clip rectangle and bitmap views themselves.
+// Like the original it reads a byte past the end of each bitmap row, so
+// bitmaps passed to it need a spare byte at the end.
+
+#ifndef KYWY_HOST_BLIT_REFERENCE
+#define KYWY_HOST_BLIT_REFERENCE 1
+
+#include "Display.hpp"
+
+#define REFERENCE_WIDTH 144
+#define REFERENCE_HEIGHT 168
+#define REFERENCE_BUFFER_SIZE (REFERENCE_WIDTH * REFERENCE_HEIGHT / 8)
+
+static bool referenceCrop(int16_t &x, int16_t &y, uint16_t &width, uint16_t &height) {
+  int32_t left = x > 0 ? x : 0, top = y > 0 ? y : 0;
+  int32_t right = (int32_t)x + width, bottom = (int32_t)y + height;
+  right = right < REFERENCE_WIDTH ? right : REFERENCE_WIDTH;
+  bottom = bottom < REFERENCE_HEIGHT ? bottom : REFERENCE_HEIGHT;
+
+  if (left >= right || top >= bottom)
+    return false;
+
+  x = left;
+  y = top;
+  width = right - left;
+  height = bottom - top;
+  return true;
+}
+
+static void referenceBlit(uint8_t *screenBuffer, int16_t x, int16_t y, uint16_t width,
+                          uint16_t height, const uint8_t *bitmap,
+                          Display::BitmapOptions options, bool block,
+                          uint16_t blockColor) {
+
+  // we can write from an arbitrary chunk of the bitmap to an arbitrary chunk of
+  // the screen buffer
+  uint16_t bitmapX = 0, bitmapY = 0, bitmapWidth = width;
+
+  if (x < 0)
+    bitmapX += -1 * x;  // left edge of bitmap is off screen
+
+  if (y < 0)
+    bitmapY += -1 * y;  // top edge of bitmap is off screen
+
+  if (!referenceCrop(x, y, width, height))
+    return;  // no overlap between bitmap and screen
+
+  // get top left corner of block to write on screen
+  uint8_t *buffer = screenBuffer + (18 * y) + (x / 8);
+
+  // index bitmap by bits instead of bytes to handle all the byte splitting
+  uint16_t bitmapBitIndex = bitmapWidth * bitmapY + bitmapX;
+
+  // precomputed values
+  uint8_t bufferBitsNotToWriteToInLeftByteColumn = x % 8;
+  uint8_t bufferBitsToWriteToInLeftByteColumn = 8 - x % 8;
+
+  // buffer wrap distance calculation
+  int splitLeftBits =
+    8 - x % 8;  // how many bits of the left most byte column need to be filled
+  splitLeftBits =
+    splitLeftBits == 8
+      ? 0
+      : splitLeftBits;  // if we have a whole column on the left just include
+                        // it as part of the inner bytes
+  int splitRightBits =
+    (x + width) % 8;  // how many bits of the right most byte column need to be filled
+  uint16_t innerBytes =
+    (width - splitLeftBits - splitRightBits) / 8;  // how many bytes are between the right and left column
+  uint16_t bufferWrapDistance =
+    18 - innerBytes - (splitLeftBits ? 1 : 0) - (splitRightBits ? 1 : 0);
+
+  // iterate over each line
+  for (int16_t j = 0; j < height; j++) {
+    uint16_t bitsLeftToWrite = width;
+
+    while (bitsLeftToWrite) {
+      uint8_t byteToWrite;
+      uint8_t bitsWritten = 0;
+      uint8_t mask =
+        0x00;  // identifies the part of the byte column we want to write
+
+      if (block) {
+        byteToWrite = blockColor;
+      } else {
+        byteToWrite =
+          ((*(bitmap + (bitmapBitIndex / 8)) << (bitmapBitIndex % 8)) | (*(bitmap + (bitmapBitIndex / 8) + 1) >> (8 - bitmapBitIndex % 8)));
+      }
+
+      if (options.getNegative()) {
+        byteToWrite = ~byteToWrite;
+      }
+
+      // we're only writing a single partial column and need to mask both sides
+      // of the byteToWrite
+      if (bufferBitsToWriteToInLeftByteColumn > width) {
+        byteToWrite =
+          byteToWrite >> bufferBitsNotToWriteToInLeftByteColumn;  // shift starting bitmap bit
+                                                                  // to match starting bit of
+                                                                  // buffer byte column
+
+        mask =
+          0xff >> bufferBitsNotToWriteToInLeftByteColumn;  // mask of left side since
+                                                           // this is a partial column
+        mask &=
+          0xff
+          << (8 - (bufferBitsNotToWriteToInLeftByteColumn + width));  // mask off right side since this is a partial column
+
+        bitsWritten = width;
+
+        // we're on the leftmost column
+      } else if (bitsLeftToWrite == width) {
+        byteToWrite =
+          byteToWrite >> bufferBitsNotToWriteToInLeftByteColumn;  // shift starting bitmap bit
+                                                                  // to match starting bit of
+                                                                  // buffer byte column
+
+        mask = 0xff >> bufferBitsNotToWriteToInLeftByteColumn;  // mask off left side
+
+        bitsWritten = bufferBitsToWriteToInLeftByteColumn;
+
+        // we're writing an inner column
+      } else if (bitsLeftToWrite >= 8) {
+        mask = 0xff;  // don't mask off anything
+
+        bitsWritten = 8;
+
+        // we're writing the rightmost column
+      } else if ((bitsLeftToWrite > 0) & (bitsLeftToWrite < 8)) {
+        mask = 0xff << (8 - bitsLeftToWrite);  // mask off right side
+
+        bitsWritten = bitsLeftToWrite;
+      }
+
+      // actually do the writing
+      if (!options.getOpaque()) {
+        if (options.getColor()) {
+          *buffer |= (~byteToWrite) & mask;
+        } else {
+          *buffer &= byteToWrite | (~mask);
+        }
+      } else {
+        if (options.getColor()) {
+          *buffer = (*buffer & ~mask) | (~byteToWrite & mask);
+        } else {
+          *buffer = (*buffer & ~mask) | (byteToWrite & mask);
+        }
+      }
+
+      // advance our tracking variables
+      buffer += 1;
+      bitmapBitIndex += bitsWritten;
+      bitsLeftToWrite -= bitsWritten;
+    }
+
+    // advance to the next line on the bitmap and buffer
+    bitmapBitIndex += bitmapWidth - width;
+    buffer += bufferWrapDistance;
+  }
+}
+
+#endif
@@ -0,0 +1,245 @@
+// SPDX-FileCopyrightText: 2025 KOINSLOT, Inc.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// Checks the row blit kernels against the byte-at-a-time kernel they replaced
+// (see BlitReference.hpp) with random blits onto a random screen, every pixel
+// has to match:
+//   - bitmaps and blocks (with any fill byte) in every opaque x negative x
+//     color combination
+//   - byte aligned blits, which take the straight copy path, and unaligned
+//     ones
+//   - blocks hanging off every edge of the screen
+//   - a clip rectangle, outside of which nothing may change, a block's fill
+//     pattern starts at the first pixel inside it
+//   - views into a larger bitmap, against the same rectangle copied out first
+
+#include <random>
+#include <string.h>
+
+#include "BlitReference.hpp"
+#include "Check.hpp"
+
+#define CASES 10000
+
+static std::mt19937 generator(1);
+
+static Display::Driver::MBED_SPI_DRIVER driver;
+static uint8_t reference[REFERENCE_BUFFER_SIZE];
+
+// plenty for any blit below, plus the byte the reference reads past the end
+static uint8_t bitmap[4096 + 1];
+
+static int randomInt(int from, int to) {
+  return from + (int)(generator() % (to - from));
+}
+
+// the same random screen in the driver and the reference
+static void randomizeScreen() {
+  static uint8_t screen[REFERENCE_BUFFER_SIZE];
+  for (uint8_t &byte : screen) {
+    byte = generator();
+  }
+  memcpy(reference, screen, sizeof(reference));
+
+  driver.clearClip();
+  driver.writeBitmapToBuffer(0, 0, REFERENCE_WIDTH, REFERENCE_HEIGHT, screen,
+                             Display::BitmapOptions().opaque(true));
+}
+
+static void randomizeBitmap() {
+  for (uint8_t &byte : bitmap) {
+    byte = generator();
+  }
+}
+
+static Display::BitmapOptions randomOptions() {
+  return Display::BitmapOptions()
+    .opaque(generator() & 1)
+    .negative(generator() & 1)
+    .color(generator() & 1 ? 0xff : 0x00);
+}
+
+// solid colors most of the time, patterns show up any misplaced shift
+static uint16_t randomBlockColor() {
+  switch (generator() % 3) {
+    case 0:
+      return 0x00;
+    case 1:
+      return 0xff;
+    default:
+      return generator() & 0xff;
+  }
+}
+
+static bool referencePixel(const uint8_t *buffer, int16_t x, int16_t y) {
+  return buffer[18 * y + x / 8] & (1 << (7 - x % 8));
+}
+
+// counts the case as a mismatch if any pixel differs from `expected`
+static void compare(const uint8_t *expected, uint32_t &mismatches, const char *what,
+                    int16_t x, int16_t y, uint16_t width, uint16_t height) {
+  for (int16_t j = 0; j < REFERENCE_HEIGHT; j++) {
+    for (int16_t i = 0; i < REFERENCE_WIDTH; i++) {
+      if ((driver.getBufferPixel(i, j) != 0) != referencePixel(expected, i, j)) {
+        if (mismatches++ < 5) {
+          printf("  %s at %d,%d %ux%u differs at pixel %d,%d\n", what, x, y,
+                 width, height, i, j);
+        }
+        return;
+      }
+    }
+  }
+}
+
+static void randomBlock(int16_t &x, int16_t &y, uint16_t &width, uint16_t &height,
+                        bool &aligned) {
+  width = randomInt(1, 71);
+  height = randomInt(1, 41);
+  x = randomInt(-40, REFERENCE_WIDTH + 10);
+  y = randomInt(-40, REFERENCE_HEIGHT + 10);
+
+  // both ends on a byte boundary
+  aligned = generator() % 3 == 0;
+  if (aligned) {
+    x -= ((x % 8) + 8) % 8;
+    width = (width + 7) / 8 * 8;
+  }
+}
+
+static void checkBlits() {
+  printf(" bitmaps and blocks\n");
+  uint32_t mismatches = 0, alignedCases = 0;
+
+  for (uint32_t n = 0; n < CASES; n++) {
+    randomizeScreen();
+    randomizeBitmap();
+
+    int16_t x, y;
+    uint16_t width, height;
+    bool aligned;
+    randomBlock(x, y, width, height, aligned);
+    alignedCases += aligned;
+
+    bool block = generator() % 4 == 0;
+    uint16_t blockColor = randomBlockColor();
+    Display::BitmapOptions options = randomOptions();
+
+    referenceBlit(reference, x, y, width, height, block ? nullptr : bitmap, options, block, blockColor);
+    driver.writeBitmapOrBlockToBuffer(x, y, width, height, block ? nullptr : bitmap, options, block, blockColor);
+    compare(reference, mismatches, block ? "block" : "bitmap", x, y, width, height);
+  }
+
+  CHECK_EQUAL(mismatches, 0);
+  CHECK(alignedCases > CASES / 4);
+}
+
+static void checkClip() {
+  printf(" clip rectangle\n");
+  uint32_t mismatches = 0;
+  static uint8_t unclipped[REFERENCE_BUFFER_SIZE];
+
+  for (uint32_t n = 0; n < CASES; n++) {
+    randomizeScreen();
+    randomizeBitmap();
+
+    int16_t clipX = randomInt(-10, REFERENCE_WIDTH), clipY = randomInt(-10, REFERENCE_HEIGHT);
+    uint16_t clipWidth = randomInt(1, 100), clipHeight = randomInt(1, 100);
+    driver.setClip(clipX, clipY, clipWidth, clipHeight);
+
+    int16_t x, y;
+    uint16_t width, height;
+    bool aligned;
+    randomBlock(x, y, width, height, aligned);
+
+    bool block = generator() % 4 == 0;
+    uint16_t blockColor = randomBlockColor();
+    Display::BitmapOptions options = randomOptions();
+
+    if (block) {
+      // a fill pattern starts at the first pixel drawn, so a clipped block is
+      // the block cropped to the clip
+      int16_t left = x > clipX ? x : clipX, top = y > clipY ? y : clipY;
+      int16_t right = x + width < clipX + clipWidth ? x + width : clipX + clipWidth;
+      int16_t bottom = y + height < clipY + clipHeight ? y + height : clipY + clipHeight;
+      if (left < right && top < bottom) {
+        referenceBlit(reference, left, top, right - left, bottom - top, nullptr, options, true, blockColor);
+      }
+    } else {
+      // the unclipped blit, with only the pixels inside the clip kept
+      memcpy(unclipped, reference, sizeof(unclipped));
+      referenceBlit(unclipped, x, y, width, height, bitmap, options, false, 0x00);
+      for (int16_t j = 0; j < REFERENCE_HEIGHT; j++) {
+        for (int16_t i = 0; i < REFERENCE_WIDTH; i++) {
+          if (i >= clipX && j >= clipY && i < clipX + clipWidth && j < clipY + clipHeight) {
+            uint8_t bit = 1 << (7 - i % 8);
+            reference[18 * j + i / 8] = (reference[18 * j + i / 8] & ~bit) | (unclipped[18 * j + i / 8] & bit);
+          }
+        }
+      }
+    }
+
+    driver.writeBitmapOrBlockToBuffer(x, y, width, height, block ? nullptr : bitmap, options, block, blockColor);
+    compare(reference, mismatches, block ? "clipped block" : "clipped bitmap", x, y, width, height);
+  }
+
+  driver.clearClip();
+  CHECK_EQUAL(mismatches, 0);
+}
+
+static void checkViews() {
+  printf(" bitmap views\n");
+  uint32_t mismatches = 0;
+  static uint8_t copy[4096 + 1];
+
+  for (uint32_t n = 0; n < CASES; n++) {
+    randomizeScreen();
+    randomizeBitmap();
+
+    int16_t x, y;
+    uint16_t width, height;
+    bool aligned;
+    randomBlock(x, y, width, height, aligned);
+
+    // a rectangle somewhere in a sheet up to 150 pixels wide, aligned views
+    // start on a byte in a sheet a whole number of bytes wide
+    Display::BitmapView view;
+    view.bitmap = bitmap;
+    view.width = width;
+    view.height = height;
+    view.stride = width + randomInt(0, 80);
+    view.x = randomInt(0, view.stride - width + 1);
+    view.y = randomInt(0, 20);
+    if (aligned) {
+      view.stride = (view.stride + 7) / 8 * 8;
+      view.x -= view.x % 8;
+    }
+
+    // the same rectangle copied out of the sheet
+    memset(copy, 0, sizeof(copy));
+    for (uint16_t j = 0; j < height; j++) {
+      for (uint16_t i = 0; i < width; i++) {
+        uint32_t from = (uint32_t)(view.y + j) * view.stride + view.x + i;
+        uint32_t to = (uint32_t)j * width + i;
+        if (bitmap[from / 8] & (0x80 >> from % 8)) {
+          copy[to / 8] |= 0x80 >> to % 8;
+        }
+      }
+    }
+
+    Display::BitmapOptions options = randomOptions();
+    referenceBlit(reference, x, y, width, height, copy, options, false, 0x00);
+    driver.writeBitmapViewToBuffer(x, y, view, options);
+    compare(reference, mismatches, "view", x, y, width, height);
+  }
+
+  CHECK_EQUAL(mismatches, 0);
+}
+
+int main() {
+  checkBlits();
+  checkClip();
+  checkViews();
+
+  return checkResult();
+}
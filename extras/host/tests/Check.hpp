@@ -0,0 +1,40 @@
+// SPDX-FileCopyrightText: 2025 KOINSLOT, Inc.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// Assertions for the host tests, a test's main returns `checkResult()`
+
+#ifndef KYWY_HOST_CHECK
+#define KYWY_HOST_CHECK 1
+
+#include <stdio.h>
+
+static int checkFailures = 0;
+
+#define CHECK(condition) \
+  do { \
+    if (!(condition)) { \
+      printf("  FAILED %s:%d: %s\n", __FILE__, __LINE__, #condition); \
+      checkFailures++; \
+    } \
+  } while (0)
+
+#define CHECK_EQUAL(actual, expected) \
+  do { \
+    long long checkActual = (long long)(actual), checkExpected = (long long)(expected); \
+    if (checkActual != checkExpected) { \
+      printf("  FAILED %s:%d: %s is %lld, expected %lld\n", __FILE__, __LINE__, #actual, checkActual, checkExpected); \
+      checkFailures++; \
+    } \
+  } while (0)
+
+static inline int checkResult() {
+  if (checkFailures) {
+    printf("  %d check(s) failed\n", checkFailures);
+    return 1;
+  }
+  printf("  passed\n");
+  return 0;
+}
+
+#endif
@@ -0,0 +1,270 @@
+// SPDX-FileCopyrightText: 2023 - 2025 KOINSLOT, Inc.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// Checks that circles drawn as spans are pixel for pixel the circles drawn by
+// the pixel and block code they replaced, kept below as the reference. Covers
+// diameters 0 to 120 from every origin, outlines and fills, black and white,
+// on and off the screen, with a clip rectangle and in two rotations.
+
+#include <random>
+
+#include "Check.hpp"
+#include "Display.hpp"
+
+static void referenceEvenCircle(Display::Driver::Driver *driver, int16_t x,
+                                int16_t y, uint16_t diameter, uint16_t color,
+                                bool fill) {
+  int16_t radius = diameter / 2;
+  int16_t xOffset = 0, yOffset = -radius + 1;
+
+  int16_t xTopLeftCenter = x + radius - 1, yTopLeftCenter = y + radius - 1;
+  int16_t xTopRightCenter = x + radius - 0, yTopRightCenter = y + radius - 1;
+  int16_t xBottomLeftCenter = x + radius - 1,
+          yBottomLeftCenter = y + radius - 0;
+  int16_t xBottomRightCenter = x + radius - 0,
+          yBottomRightCenter = y + radius - 0;
+
+  int16_t discriminatorThreshold;
+  if (radius <= 3) {
+    discriminatorThreshold = 0;
+  } else if (radius <= 6) {
+    discriminatorThreshold = 3;
+  } else {
+    discriminatorThreshold = 5;
+  }
+
+  while (xOffset <= (-1 * yOffset)) {
+    // leverage 8-way symmetry
+
+    if (fill) {
+      driver->setBufferBlock(xTopLeftCenter - xOffset, yTopLeftCenter + yOffset,
+                             2 * (abs(xOffset) + 1), 1, color);
+      driver->setBufferBlock(xTopLeftCenter + yOffset, yTopLeftCenter - xOffset,
+                             2 * (abs(yOffset) + 1), 1, color);
+      driver->setBufferBlock(xBottomLeftCenter - xOffset,
+                             yBottomLeftCenter - yOffset,
+                             2 * (abs(xOffset) + 1), 1, color);
+      driver->setBufferBlock(xBottomLeftCenter + yOffset,
+                             yBottomLeftCenter + xOffset,
+                             2 * (abs(yOffset) + 1), 1, color);
+    } else {
+      // top left quadrant
+      driver->setBufferPixel(xTopLeftCenter - xOffset, yTopLeftCenter + yOffset,
+                             color);
+      driver->setBufferPixel(xTopLeftCenter + yOffset, yTopLeftCenter - xOffset,
+                             color);
+
+      // top right quadrant
+      driver->setBufferPixel(xTopRightCenter + xOffset,
+                             yTopRightCenter + yOffset, color);
+      driver->setBufferPixel(xTopRightCenter - yOffset,
+                             yTopRightCenter - xOffset, color);
+
+      // bottom left quadrant
+      driver->setBufferPixel(xBottomLeftCenter - xOffset,
+                             yBottomLeftCenter - yOffset, color);
+      driver->setBufferPixel(xBottomLeftCenter + yOffset,
+                             yBottomLeftCenter + xOffset, color);
+
+      // bottom right quadrant
+      driver->setBufferPixel(xBottomRightCenter + xOffset,
+                             yBottomRightCenter - yOffset, color);
+      driver->setBufferPixel(xBottomRightCenter - yOffset,
+                             yBottomRightCenter + xOffset, color);
+    }
+
+    xOffset++;
+
+    int16_t discriminator = (xOffset * xOffset) + (yOffset * yOffset) - ((radius - 1) * (radius - 1));
+    if (discriminator > discriminatorThreshold) {
+      yOffset++;
+    }
+  }
+}
+
+static void referenceOddCircle(Display::Driver::Driver *driver, int16_t x,
+                               int16_t y, uint16_t diameter, uint16_t color,
+                               bool fill) {
+  int16_t radius = diameter / 2;
+  int16_t xOffset = 0, yOffset = -radius;
+
+  int16_t discriminatorThreshold;
+  switch (radius) {
+    case 1:
+      discriminatorThreshold = 0;
+      break;
+    case 2:
+      discriminatorThreshold = 1;
+      break;
+    case 3:
+      discriminatorThreshold = 3;
+      break;
+    default:
+      discriminatorThreshold = 5;
+  }
+
+  while (xOffset <= (-1 * yOffset)) {
+
+    if (fill) {
+      driver->setBufferBlock(x - xOffset, y + yOffset, 2 * abs(xOffset) + 1, 1,
+                             color);
+      driver->setBufferBlock(x + yOffset, y - xOffset, 2 * abs(yOffset) + 1, 1,
+                             color);
+      driver->setBufferBlock(x - xOffset, y - yOffset, 2 * abs(xOffset) + 1, 1,
+                             color);
+      driver->setBufferBlock(x + yOffset, y + xOffset, 2 * abs(yOffset) + 1, 1,
+                             color);
+
+    } else {
+      // leverage 8-way symmetry
+      driver->setBufferPixel(x + xOffset, y + yOffset, color);
+      driver->setBufferPixel(x + xOffset, y - yOffset, color);
+      driver->setBufferPixel(x - xOffset, y + yOffset, color);
+      driver->setBufferPixel(x - xOffset, y - yOffset, color);
+      driver->setBufferPixel(x + yOffset, y + xOffset, color);
+      driver->setBufferPixel(x + yOffset, y - xOffset, color);
+      driver->setBufferPixel(x - yOffset, y + xOffset, color);
+      driver->setBufferPixel(x - yOffset, y - xOffset, color);
+    }
+    xOffset++;
+
+    int16_t discriminator =
+      (xOffset * xOffset) + (yOffset * yOffset) - (radius * radius);
+    if (discriminator > discriminatorThreshold) {
+      yOffset++;
+    }
+  }
+}
+
+static void referenceCircle(Display::Driver::Driver *driver,
+                            Display::Origin::Object2D origin, int16_t x,
+                            int16_t y, uint16_t diameter, uint16_t color,
+                            bool fill) {
+  if (diameter % 2 == 0) {
+    switch (origin) {
+      case Display::Origin::Object2D::TOP_LEFT:
+        referenceEvenCircle(driver, x, y, diameter, color, fill);
+        break;
+      case Display::Origin::Object2D::TOP_RIGHT:
+        referenceEvenCircle(driver, x - diameter, y, diameter, color, fill);
+        break;
+      case Display::Origin::Object2D::BOTTOM_LEFT:
+        referenceEvenCircle(driver, x, y - diameter, diameter, color, fill);
+        break;
+      case Display::Origin::Object2D::BOTTOM_RIGHT:
+        referenceEvenCircle(driver, x - diameter, y - diameter, diameter, color, fill);
+        break;
+      case Display::Origin::Object2D::CENTER:
+        referenceEvenCircle(driver, x - (diameter / 2), y - (diameter / 2), diameter, color, fill);
+        break;
+    }
+  } else {
+    switch (origin) {
+      case Display::Origin::Object2D::TOP_LEFT:
+        referenceOddCircle(driver, x + (diameter / 2), y + (diameter / 2), diameter, color, fill);
+        break;
+      case Display::Origin::Object2D::TOP_RIGHT:
+        referenceOddCircle(driver, x - (diameter / 2), y + (diameter / 2), diameter, color, fill);
+        break;
+      case Display::Origin::Object2D::BOTTOM_LEFT:
+        referenceOddCircle(driver, x + (diameter / 2), y - (diameter / 2), diameter, color, fill);
+        break;
+      case Display::Origin::Object2D::BOTTOM_RIGHT:
+        referenceOddCircle(driver, x - (diameter / 2), y - (diameter / 2), diameter, color, fill);
+        break;
+      case Display::Origin::Object2D::CENTER:
+        referenceOddCircle(driver, x, y, diameter, color, fill);
+        break;
+    }
+  }
+}
+
+static bool sameBuffers(Display::Driver::Driver &a, Display::Driver::Driver &b) {
+  for (int16_t y = 0; y < a.getHeight(); y++) {
+    for (int16_t x = 0; x < a.getWidth(); x++) {
+      if (a.getBufferPixel(x, y) != b.getBufferPixel(x, y)) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+int main() {
+  Display::Driver::MBED_SPI_DRIVER driver, referenceDriver;
+  Display::Display display(&driver);
+
+  Display::Origin::Object2D origins[] = {
+    Display::Origin::Object2D::TOP_LEFT,
+    Display::Origin::Object2D::TOP_RIGHT,
+    Display::Origin::Object2D::BOTTOM_LEFT,
+    Display::Origin::Object2D::BOTTOM_RIGHT,
+    Display::Origin::Object2D::CENTER,
+  };
+  Display::Rotation rotations[] = { Display::Rotation::DEFAULT, Display::Rotation::CLOCKWISE_90 };
+
+  std::mt19937 generator(11);
+  uint32_t cases = 0, mismatches = 0;
+
+  for (Display::Rotation rotation : rotations) {
+    display.setRotation(rotation);
+    referenceDriver.setRotation(rotation);
+
+    for (uint16_t diameter = 0; diameter <= 120; diameter++) {
+      for (Display::Origin::Object2D origin : origins) {
+        for (uint8_t fill = 0; fill < 2; fill++) {
+          // centered, then anywhere in black, in white, and in white clipped
+          for (uint8_t variant = 0; variant < 4; variant++) {
+            int16_t x = 72, y = 84;
+            if (variant) {
+              x = (int16_t)(generator() % 240) - 48;
+              y = (int16_t)(generator() % 260) - 46;
+            }
+            uint16_t color = variant % 2 ? 0xff : 0x00;
+
+            int16_t clipX = 0, clipY = 0;
+            uint16_t clipWidth = 0, clipHeight = 0;
+            if (variant == 3) {
+              clipX = generator() % 100;
+              clipY = generator() % 100;
+              clipWidth = generator() % 80;
+              clipHeight = generator() % 80;
+            }
+
+            for (Display::Driver::Driver *target : { (Display::Driver::Driver *)&driver, (Display::Driver::Driver *)&referenceDriver }) {
+              target->clearBuffer();
+              if (color) {
+                target->setBufferBlock(0, 0, 200, 200, 0x00);
+              }
+              if (variant == 3) {
+                target->setClip(clipX, clipY, clipWidth, clipHeight);
+              }
+            }
+
+            Display::Object2DOptions options = Display::Object2DOptions().origin(origin).color(color);
+            if (fill) {
+              display.fillCircle(x, y, diameter, options);
+            } else {
+              display.drawCircle(x, y, diameter, options);
+            }
+            referenceCircle(&referenceDriver, origin, x, y, diameter, color, fill);
+
+            driver.clearClip();
+            referenceDriver.clearClip();
+
+            cases++;
+            if (!sameBuffers(driver, referenceDriver) && mismatches++ < 5) {
+              printf("  %s of diameter %u at %d,%d differs\n", fill ? "fill" : "outline", diameter, x, y);
+            }
+          }
+        }
+      }
+    }
+  }
+
+  CHECK_EQUAL(cases, 9680);
+  CHECK_EQUAL(mismatches, 0);
+
+  return checkResult();
+}
@@ -0,0 +1,71 @@
+// SPDX-FileCopyrightText: 2025 KOINSLOT, Inc.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// Checks that `Font::getCharacter` finds the same glyph as the walk it
+// replaced (see GlyphReference.hpp) for every code from 1 to 0xffff in every
+// bundled font, through the glyph index and through the walk fonts fall back
+// to when every cached index is pinned by other fonts.
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "Check.hpp"
+#include "Fonts.hpp"
+#include "GlyphReference.hpp"
+
+static const uint8_t *fonts[] = {
+  Display::Font::bailleul_8_pt,
+  Display::Font::bailleul_12_pt,
+  Display::Font::bailleul_16_pt,
+  Display::Font::bailleul_bold_8_pt,
+  Display::Font::bailleul_bold_12_pt,
+  Display::Font::bailleul_bold_16_pt,
+  Display::Font::intel_one_mono_8_pt,
+  Display::Font::intel_one_mono_12_pt,
+  Display::Font::intel_one_mono_16_pt,
+};
+
+// returns how many codes find a different glyph than the reference
+static uint32_t compareAll(Display::Font::Font &font) {
+  // quiet the message printed for every missing character
+  fflush(stdout);
+  int out = dup(STDOUT_FILENO), null = open("/dev/null", O_WRONLY);
+  dup2(null, STDOUT_FILENO);
+
+  uint32_t mismatches = 0;
+  for (uint32_t character = 1; character <= 0xffff; character++) {
+    if (font.getCharacter(character).bitmap != referenceLookup(font, character) + CHARACTER_BITMAP) {
+      mismatches++;
+    }
+  }
+
+  fflush(stdout);
+  dup2(out, STDOUT_FILENO);
+  close(out);
+  close(null);
+  return mismatches;
+}
+
+int main() {
+  printf(" indexed\n");
+  for (const uint8_t *data : fonts) {
+    Display::Font::Font font(data);
+    CHECK_EQUAL(compareAll(font), 0);
+  }
+
+  printf(" every index pinned\n");
+  Display::Font::Font *pinned[FONT_INDEX_CACHE_SIZE];
+  for (uint8_t i = 0; i < FONT_INDEX_CACHE_SIZE; i++) {
+    pinned[i] = new Display::Font::Font(fonts[i]);
+  }
+  for (uint8_t i = FONT_INDEX_CACHE_SIZE; i < sizeof(fonts) / sizeof(fonts[0]); i++) {
+    Display::Font::Font font(fonts[i]);
+    CHECK_EQUAL(compareAll(font), 0);
+  }
+  for (Display::Font::Font *font : pinned) {
+    delete font;
+  }
+
+  return checkResult();
+}
@@ -0,0 +1,37 @@
+// SPDX-FileCopyrightText: 2023 - 2025 KOINSLOT, Inc.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// The glyph lookup `Font::getCharacter` used before glyph indexes, kept as the
+// reference they are checked and measured against. It walks the glyph chain
+// from the start of the font on every call, and no longer prints missing
+// characters.
+
+#ifndef KYWY_HOST_GLYPH_REFERENCE
+#define KYWY_HOST_GLYPH_REFERENCE 1
+
+#include "Font.hpp"
+
+static const uint8_t *referenceLookup(const Display::Font::Font &font, uint16_t character) {
+  const uint8_t *currentCharacter = font.firstCharacter;
+
+  // first character is always the missing character replacement glyph so skip
+  // it
+  currentCharacter += 256U * *(currentCharacter + CHARACTER_BYTES) + *(currentCharacter + CHARACTER_BYTES + 1);
+
+  uint16_t charactersLeft = font.numCharacters;
+
+  while (256U * *(currentCharacter) + *(currentCharacter + 1) != character) {
+    charactersLeft--;
+    currentCharacter += 256U * *(currentCharacter + CHARACTER_BYTES) + *(currentCharacter + CHARACTER_BYTES + 1);
+
+    if (charactersLeft <= 0) {  // if we didn't find the character use the
+                                // missing character replacement glyph
+      return font.firstCharacter;
+    }
+  }
+
+  return currentCharacter;
+}
+
+#endif
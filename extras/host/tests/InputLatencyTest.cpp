@@ -0,0 +1,194 @@
+// SPDX-FileCopyrightText: 2025 KOINSLOT, Inc.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// Simulates 2000 presses with contact bounce on random buttons at random
+// times, polled once per tick and then caught by interrupts, and checks what
+// an actor handling them can tell about when they happened:
+//   - every press and release happened between `ButtonEvent::since` and
+//     `time`, give or take the contact bounce
+//   - when polling, half way in between estimates the average time from press
+//     to handle, and from `since` bounds the worst
+//   - `InputStats` reports the same
+//   - interrupts catch every press as it happens, polling misses some presses
+//     shorter than a tick
+// The on-device counterpart is examples/utility/InputLatency.
+
+#include <random>
+
+#include "Check.hpp"
+#include "Events.hpp"
+#include "Input.hpp"
+
+#define TICK_DURATION 33000
+#define PRESSES 2000
+#define BOUNCE 2000  // contact bounce lasts this long after a press
+
+// indexed by `Kywy::Button`
+static const uint8_t pins[Kywy::BUTTON_COUNT] = {
+  KYWY_LEFT_BUTTON,
+  KYWY_RIGHT_BUTTON,
+  KYWY_D_PAD_LEFT,
+  KYWY_D_PAD_RIGHT,
+  KYWY_D_PAD_UP,
+  KYWY_D_PAD_DOWN,
+  KYWY_D_PAD_CENTER,
+};
+
+class Ticker : public Actor::Actor {
+public:
+  void handle(::Actor::Message *) {}
+};
+
+class Sink : public Actor::Actor {
+public:
+  // micros() each button was last pressed and released at
+  uint32_t pressedAt[Kywy::BUTTON_COUNT] = {};
+  uint32_t releasedAt[Kywy::BUTTON_COUNT] = {};
+
+  uint32_t presses = 0, releases = 0;
+  uint32_t outOfRange = 0;      // changes that didn't happen between `since` and `time`
+  uint64_t totalLatency = 0;    // from the change itself
+  uint64_t totalEstimated = 0;  // from half way between `since` and `time`
+  uint32_t maxLatency = 0;
+  uint32_t maxBound = 0;  // from `since`
+
+  void handle(::Actor::Message *message) {
+    if (message->signal < Kywy::Events::BUTTON_LEFT_PRESSED || message->signal > Kywy::Events::D_PAD_CENTER_RELEASED) {
+      return;
+    }
+
+    Kywy::ButtonEvent event = message->getPayload<Kywy::ButtonEvent>();
+    bool pressed = (message->signal - Kywy::Events::BUTTON_LEFT_PRESSED) % 2 == 0;
+    uint32_t changedAt = pressed ? pressedAt[event.button] : releasedAt[event.button];
+    (pressed ? presses : releases)++;
+
+    // a read in the middle of the bounce can still see the button as it was
+    if (changedAt > event.time || event.since > changedAt + BOUNCE) {
+      outOfRange++;
+    }
+
+    uint32_t now = micros();
+    uint32_t latency = now - changedAt;
+    totalLatency += latency;
+    totalEstimated += (now - event.time) + (event.time - event.since) / 2;
+    maxLatency = latency > maxLatency ? latency : maxLatency;
+    maxBound = now - event.since > maxBound ? now - event.since : maxBound;
+  };
+};
+
+static void drain() {
+  while (::Actor::scheduler.runOnce())
+    ;
+}
+
+static void simulate(bool interrupts) {
+  printf(" %s\n", interrupts ? "interrupts" : "polling");
+
+  Ticker ticker;
+  Kywy::Input input;
+  input.options.interrupts(interrupts);
+  input.subscribe(&ticker);
+  input.start();
+
+  Sink sink;
+  sink.subscribe(&input);
+  sink.start();
+
+  std::mt19937 generator(3);
+  uint32_t time = 1000000, nextTick = time + TICK_DURATION;
+  uint32_t longPresses = 0;  // longer than a tick and the bounce, can't be missed
+  host::setMicros(time);
+  input.initialize();
+
+  for (int i = 0; i < PRESSES; i++) {
+    Kywy::Button button = (Kywy::Button)(generator() % Kywy::BUTTON_COUNT);
+    uint32_t hold = 20000 + generator() % 150000;
+    uint32_t gap = 20000 + generator() % 200000;
+    longPresses += hold >= TICK_DURATION + BOUNCE;
+
+    // press with bounces, hold, release with bounces
+    struct {
+      uint32_t at;
+      int level;
+    } changes[] = {
+      { time, LOW },
+      { time + 300, HIGH },
+      { time + 700, LOW },
+      { time + 1500, HIGH },
+      { time + BOUNCE, LOW },
+      { time + hold, HIGH },
+      { time + hold + 400, LOW },
+      { time + hold + 900, HIGH },
+    };
+
+    for (auto &change : changes) {
+      while (nextTick <= change.at) {
+        host::setMicros(nextTick);
+        ticker.publish(::Actor::Message(Kywy::Events::TICK));
+        drain();
+        nextTick += TICK_DURATION;
+      }
+
+      // the first change of the press and of the release
+      if (&change == &changes[0]) {
+        sink.pressedAt[button] = change.at;
+      } else if (&change == &changes[5]) {
+        sink.releasedAt[button] = change.at;
+      }
+
+      // fires the input interrupt when attached
+      host::setMicros(change.at);
+      host::setPin(pins[button], change.level);
+      drain();
+    }
+
+    time += hold + gap;
+  }
+
+  // the last release is polled on the next tick
+  host::setMicros(nextTick);
+  ticker.publish(::Actor::Message(Kywy::Events::TICK));
+  drain();
+
+  uint32_t averageLatency = sink.totalLatency / (sink.presses + sink.releases);
+  uint32_t averageEstimated = sink.totalEstimated / (sink.presses + sink.releases);
+  printf("  %lu/%d presses, pressed to handled avg %luus (estimated %luus) max %luus (bound %luus)\n",
+         (unsigned long)sink.presses, PRESSES, (unsigned long)averageLatency,
+         (unsigned long)averageEstimated, (unsigned long)sink.maxLatency,
+         (unsigned long)sink.maxBound);
+
+  CHECK_EQUAL(sink.outOfRange, 0);
+  CHECK_EQUAL(sink.releases, sink.presses);
+  CHECK_EQUAL(input.stats.edges, sink.presses + sink.releases);
+  CHECK_EQUAL(input.stats.dropped, 0);
+
+  if (interrupts) {
+    // seen and handled as they happen
+    CHECK_EQUAL(sink.presses, PRESSES);
+    CHECK(input.stats.bounces > 0);  // polling reads a tick apart, after the debounce time
+    CHECK_EQUAL(sink.maxLatency, 0);
+    CHECK_EQUAL(input.stats.maxUnseen, 0);
+  } else {
+    // seen on the next tick, a tick after the read before
+    CHECK(sink.presses >= longPresses);
+    CHECK(sink.presses < PRESSES);
+    CHECK(sink.maxLatency <= TICK_DURATION + BOUNCE);
+    CHECK(sink.maxBound <= TICK_DURATION);
+    CHECK(averageLatency > TICK_DURATION / 3);
+    CHECK(averageEstimated + 1000 > averageLatency && averageEstimated < averageLatency + 1000);
+    CHECK_EQUAL(input.stats.maxUnseen, TICK_DURATION);
+    CHECK_EQUAL(input.stats.getAverageUnseen(), TICK_DURATION);
+  }
+  CHECK_EQUAL(input.stats.maxLatency, 0);  // publishing takes no fake time
+}
+
+int main() {
+  ::Actor::setSchedulerMode(::Actor::SCHEDULER_COOPERATIVE);
+
+  // the interrupts stay attached, so polling goes first
+  simulate(false);
+  simulate(true);
+
+  return checkResult();
+}
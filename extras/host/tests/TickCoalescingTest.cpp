@@ -0,0 +1,160 @@
+// SPDX-FileCopyrightText: 2025 KOINSLOT, Inc.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// Drives the clock with fake time on the cooperative scheduler and checks
+// which TICKs reach an actor that only gets to run every few ticks:
+//   - by default stale ticks are coalesced, every frame an actor misses is
+//     counted by `getCoalesced` and `DispatchStats::messagesCoalesced`, and
+//     other messages are never dropped
+//   - once a coalesced tick is taken off the queue its signal isn't pending
+//     anymore, so the next tick (even one published from the handler) is
+//     queued
+//   - with a fixed timestep nothing is coalesced, catch-up ticks included
+// The on-device counterpart is examples/utility/TickCoalescing.
+
+#include "Check.hpp"
+#include "Clock.hpp"
+#include "Events.hpp"
+
+#define TICK_DURATION 33000
+
+class Sink : public Actor::Actor {
+public:
+  uint32_t ticks = 0;
+  uint32_t nextFrame = 0;
+  uint32_t missed = 0;  // frames that never arrived
+  uint32_t inputs = 0;
+
+  Kywy::Clock *tickFrom = nullptr;  // publishes one more tick from the first one handled
+
+  void handle(::Actor::Message *message) {
+    if (message->signal != Kywy::Events::TICK) {
+      inputs++;
+      return;
+    }
+
+    uint32_t frame = message->getPayload<Kywy::Tick>().frame;
+    if (ticks++) {
+      missed += frame - nextFrame;
+    }
+    nextFrame = frame + 1;
+
+    if (tickFrom) {
+      Kywy::Clock *clock = tickFrom;
+      tickFrom = nullptr;
+      host::advanceMicros(TICK_DURATION);
+      Kywy::clockTickCallback(clock);
+    }
+  };
+};
+
+class Publisher : public Actor::Actor {
+public:
+  void handle(::Actor::Message *) {}
+};
+
+static void drain() {
+  while (::Actor::scheduler.runOnce())
+    ;
+}
+
+static void tick(Kywy::Clock &clock, uint32_t late = 0) {
+  host::advanceMicros(TICK_DURATION + late);
+  Kywy::clockTickCallback(&clock);
+}
+
+// the sink only runs every fifth tick
+static void checkCoalescing() {
+  printf(" coalescing\n");
+  Kywy::Clock clock;
+  Publisher input;
+  Sink sink;
+  sink.subscribe(&clock);
+  sink.subscribe(&input);
+  sink.start();
+  clock.initialize();
+
+  uint32_t coalescedBefore = ::Actor::dispatchStats.messagesCoalesced;
+  for (int i = 1; i <= 100; i++) {
+    tick(clock);
+    input.publish(::Actor::Message(Kywy::Events::INPUT));
+    CHECK(::Actor::scheduler.getQueued() <= 6);  // one tick and five inputs
+    if (i % 5 == 0) {
+      drain();
+    }
+  }
+  // the sink only sees the gap left by the last ticks once the next arrives
+  tick(clock);
+  drain();
+
+  CHECK_EQUAL(sink.ticks, 21);
+  CHECK_EQUAL(sink.missed, 80);
+  CHECK_EQUAL(sink.getCoalesced(), sink.missed);
+  CHECK_EQUAL(::Actor::dispatchStats.messagesCoalesced - coalescedBefore, 80);
+  CHECK_EQUAL(sink.inputs, 100);
+}
+
+static void checkPendingCleared() {
+  printf(" pending signal cleared when handled\n");
+  Kywy::Clock clock;
+  Sink sink;
+  sink.subscribe(&clock);
+  sink.start();
+  clock.initialize();
+
+  // a tick published while the previous one is being handled is queued
+  sink.tickFrom = &clock;
+  tick(clock);
+  drain();
+  CHECK_EQUAL(sink.ticks, 2);
+  CHECK_EQUAL(sink.missed, 0);
+  CHECK_EQUAL(sink.getCoalesced(), 0);
+
+  // and so is every tick once the queue is drained
+  for (int i = 0; i < 10; i++) {
+    tick(clock);
+    CHECK_EQUAL(::Actor::scheduler.getQueued(), 1);
+    drain();
+  }
+  CHECK_EQUAL(sink.ticks, 12);
+  CHECK_EQUAL(sink.getCoalesced(), 0);
+}
+
+static void checkFixedTimestep() {
+  printf(" fixed timestep\n");
+  Kywy::Clock clock;
+  clock.options.fixedTimestep(true).maxCatchUpTicks(2);
+  Sink sink;
+  sink.subscribe(&clock);
+  sink.start();
+  clock.initialize();
+
+  uint32_t coalescedBefore = ::Actor::dispatchStats.messagesCoalesced;
+  for (int i = 1; i <= 100; i++) {
+    // every tenth tick the clock wakes up 3 ticks late, 2 of the missed ticks
+    // are caught up and the oldest is skipped
+    tick(clock, i % 10 == 0 ? TICK_DURATION * 3 : 0);
+    if (i % 5 == 0) {
+      drain();
+    }
+  }
+  drain();
+
+  CHECK_EQUAL(clock.stats.skipped, 10);
+  CHECK_EQUAL(sink.ticks, 100 + 10 * 2);
+  CHECK_EQUAL(sink.missed, 0);
+  CHECK_EQUAL(sink.getCoalesced(), 0);
+  CHECK_EQUAL(::Actor::dispatchStats.messagesCoalesced - coalescedBefore, 0);
+}
+
+int main() {
+  ::Actor::setSchedulerMode(::Actor::SCHEDULER_COOPERATIVE);
+  host::setMicros(0);
+
+  checkCoalescing();
+  checkPendingCleared();
+  checkFixedTimestep();
+
+  return checkResult();
+}
@@ -0,0 +1,352 @@
+#!/usr/bin/env python3
+# SPDX-FileCopyrightText: 2025 KOINSLOT, Inc.
+# SPDX-License-Identifier: GPL-3.0-or-later
+
+"""
+Kywy Profile Decoder
+
+Decodes a profile written by `Profiler::dump` (see src/Profiler.hpp) and prints
+where the time went: per frame, per actor and signal, and per draw call.
+
+Usage:
+    # decode a capture of the serial output
+    python profile_decoder.py capture.bin
+
+    # read straight from the device (needs pyserial), asks the console for
+    # the profile if the sketch runs one
+    python profile_decoder.py --port /dev/ttyACM0
+
+The capture may contain other serial output, everything before the last
+"KYPF" marker is skipped.
+"""
+
+import argparse
+import struct
+import sys
+from collections import defaultdict
+
+MAGIC = b"KYPF"
+FORMAT_VERSION = 1
+
+RECORD = struct.Struct("<BBHIIHBB")
+
+RECORD_HANDLE, RECORD_UPDATE, RECORD_DRAW = range(3)
+
+DRAW_CALLS = [
+    "drawLine",
+    "drawCircle",
+    "fillCircle",
+    "drawRectangle",
+    "fillRectangle",
+    "drawBitmap",
+    "drawText",
+    "drawArc",
+    "drawEllipse",
+    "fillEllipse",
+    "drawRoundedRectangle",
+    "fillRoundedRectangle",
+]
+
+# kept in sync with src/Events.hpp
+EVENTS = [
+    "TICK",
+    "SET_TICK_DURATION",
+    "CLOCK_STEP",
+    "INPUT",
+    "INPUT_PRESSED",
+    "D_PAD",
+    "D_PAD_PRESSED",
+    "BUTTON_LEFT_PRESSED",
+    "BUTTON_LEFT_RELEASED",
+    "BUTTON_RIGHT_PRESSED",
+    "BUTTON_RIGHT_RELEASED",
+    "D_PAD_LEFT_PRESSED",
+    "D_PAD_LEFT_RELEASED",
+    "D_PAD_RIGHT_PRESSED",
+    "D_PAD_RIGHT_RELEASED",
+    "D_PAD_UP_PRESSED",
+    "D_PAD_UP_RELEASED",
+    "D_PAD_DOWN_PRESSED",
+    "D_PAD_DOWN_RELEASED",
+    "D_PAD_CENTER_PRESSED",
+    "D_PAD_CENTER_RELEASED",
+    "INPUT_STATE",
+    "REPLAY_FINISHED",
+    "INPUT_CAPTURED",
+    "SCENE_ENTER",
+    "SCENE_EXIT",
+    "CONSOLE_POLL",
+    "COLLISION",
+]
+
+NO_ACTOR = 0xFF
+
+
+class Record:
+    def __init__(self, data):
+        (
+            self.type,
+            self.actor,
+            self.id,
+            self.start,
+            self.duration,
+            self.wait,
+            self.depth,
+            _,
+        ) = RECORD.unpack(data)
+
+
+class Profile:
+    def __init__(self, data):
+        start = data.rfind(MAGIC)
+        if start < 0:
+            raise ValueError("no profile found (missing KYPF marker)")
+
+        offset = start + len(MAGIC)
+        header = struct.unpack_from("<BBHIB", data, offset)
+        version, record_size, num_records, self.written, num_actors = header
+        offset += 9
+
+        if version != FORMAT_VERSION:
+            raise ValueError(f"unsupported profile version {version}")
+        if record_size != RECORD.size:
+            raise ValueError(f"unexpected record size {record_size}")
+
+        self.actors = {}
+        for _ in range(num_actors):
+            actor, length = struct.unpack_from("<BB", data, offset)
+            offset += 2
+            name = data[offset : offset + length].decode("ascii", "replace")
+            offset += length
+            self.actors[actor] = name or f"actor {actor}"
+
+        end = offset + num_records * record_size
+        if len(data) < end:
+            raise ValueError(
+                f"profile truncated, expected {num_records} records but got "
+                f"{(len(data) - offset) // record_size}"
+            )
+
+        self.records = [
+            Record(data[i : i + record_size])
+            for i in range(offset, end, record_size)
+        ]
+
+    def actor_name(self, actor):
+        if actor == NO_ACTOR:
+            return "(no actor)"
+        return self.actors.get(actor, f"actor {actor}")
+
+
+def signal_name(signal):
+    if signal < len(EVENTS):
+        return EVENTS[signal]
+    return f"USER_EVENTS+{signal - len(EVENTS)}"
+
+
+def draw_call_name(call):
+    return DRAW_CALLS[call] if call < len(DRAW_CALLS) else f"draw call {call}"
+
+
+def percentile(values, fraction):
+    ordered = sorted(values)
+    return ordered[min(len(ordered) - 1, int(len(ordered) * fraction))]
+
+
+def print_table(title, rows, columns):
+    print(title)
+    if not rows:
+        print("  (none)\n")
+        return
+
+    widths = [
+        max(len(column), *(len(str(row[i])) for row in rows))
+        for i, column in enumerate(columns)
+    ]
+
+    def line(values):
+        # first column is a label, the rest are numbers
+        cells = [str(v).rjust(w) for v, w in zip(values, widths)]
+        cells[0] = str(values[0]).ljust(widths[0])
+        return "  " + "  ".join(cells)
+
+    print(line(columns))
+    for row in rows:
+        print(line(row))
+    print()
+
+
+def summarize(durations):
+    return [
+        len(durations),
+        sum(durations),
+        sum(durations) // len(durations),
+        percentile(durations, 0.99),
+        max(durations),
+    ]
+
+
+def print_frames(profile, limit):
+    # a frame is everything up to and including a display update
+    frames = []
+    current = defaultdict(int)
+    for record in profile.records:
+        if record.type == RECORD_HANDLE:
+            current[profile.actor_name(record.actor)] += record.duration
+        elif record.type == RECORD_UPDATE:
+            current["update"] += record.duration
+            frames.append((record.start, current))
+            current = defaultdict(int)
+
+    rows = []
+    previous = None
+    for start, totals in frames[-limit:]:
+        period = start - previous if previous is not None else ""
+        previous = start
+        handlers = ", ".join(
+            f"{name} {us}" for name, us in sorted(totals.items()) if name != "update"
+        )
+        rows.append([start, period, totals["update"], handlers])
+
+    print_table(
+        f"Frames (last {len(rows)} of {len(frames)}, us)",
+        rows,
+        ["start", "period", "update", "handlers"],
+    )
+
+
+def print_handlers(profile):
+    durations = defaultdict(list)
+    waits = defaultdict(int)
+    depths = defaultdict(int)
+    for record in profile.records:
+        if record.type != RECORD_HANDLE:
+            continue
+        key = (profile.actor_name(record.actor), signal_name(record.id))
+        durations[key].append(record.duration)
+        waits[key] = max(waits[key], record.wait)
+        depths[key] = max(depths[key], record.depth)
+
+    rows = [
+        [f"{actor} {signal}"]
+        + summarize(d)
+        + [waits[(actor, signal)], depths[(actor, signal)]]
+        for (actor, signal), d in sorted(
+            durations.items(), key=lambda item: -sum(item[1])
+        )
+    ]
+    print_table(
+        "Handlers (us)",
+        rows,
+        [
+            "actor signal",
+            "count",
+            "total",
+            "avg",
+            "p99",
+            "max",
+            "max wait",
+            "max depth",
+        ],
+    )
+
+
+def print_draw_calls(profile):
+    durations = defaultdict(list)
+    for record in profile.records:
+        if record.type == RECORD_DRAW:
+            key = (profile.actor_name(record.actor), draw_call_name(record.id))
+            durations[key].append(record.duration)
+
+    rows = [
+        [f"{actor} {call}"] + summarize(d)
+        for (actor, call), d in sorted(
+            durations.items(), key=lambda item: -sum(item[1])
+        )
+    ]
+    print_table(
+        "Draw calls (us)", rows, ["actor call", "count", "total", "avg", "p99", "max"]
+    )
+
+
+def read_serial(port, baud, timeout, request):
+    try:
+        import serial
+    except ImportError:
+        sys.exit("reading from a port needs pyserial: pip install pyserial")
+
+    data = bytearray()
+    with serial.Serial(port, baud, timeout=timeout) as device:
+        if request:
+            # sketches running the console dump on request, others ignore it
+            device.write(b"dump profile\n")
+        while True:
+            chunk = device.read(4096)
+            if not chunk:
+                break  # nothing for `timeout` seconds, assume the dump is done
+            data += chunk
+    return bytes(data)
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Decode a profile written by Profiler::dump",
+        formatter_class=argparse.RawDescriptionHelpFormatter,
+        epilog="""
+Examples:
+  # decode a capture of the serial output
+  python profile_decoder.py capture.bin
+
+  # read from the device until it goes quiet for 2 seconds
+  python profile_decoder.py --port /dev/ttyACM0 --timeout 2
+        """,
+    )
+    parser.add_argument(
+        "capture", nargs="?", help="file with the captured serial output, - for stdin"
+    )
+    parser.add_argument("--port", help="serial port to read the profile from instead")
+    parser.add_argument(
+        "--baud", type=int, default=115200, help="baud rate (default: 115200)"
+    )
+    parser.add_argument(
+        "--timeout",
+        type=float,
+        default=2,
+        help="seconds of silence that end a read from --port (default: 2)",
+    )
+    parser.add_argument(
+        "--no-request",
+        action="store_true",
+        help="don't send `dump profile` to the console, wait for the sketch to dump",
+    )
+    parser.add_argument(
+        "--frames", type=int, default=10, help="frames to list (default: 10)"
+    )
+    args = parser.parse_args()
+
+    if args.port:
+        data = read_serial(args.port, args.baud, args.timeout, not args.no_request)
+    elif args.capture == "-":
+        data = sys.stdin.buffer.read()
+    elif args.capture:
+        with open(args.capture, "rb") as f:
+            data = f.read()
+    else:
+        parser.error("give a capture file or --port")
+
+    try:
+        profile = Profile(data)
+    except (ValueError, struct.error) as e:
+        sys.exit(f"error: {e}")
+
+    dropped = profile.written - len(profile.records)
+    print(f"{len(profile.records)} records, {len(profile.actors)} actors", end="")
+    print(f", {dropped} older records overwritten\n" if dropped else "\n")
+
+    print_frames(profile, args.frames)
+    print_handlers(profile)
+    print_draw_calls(profile)
+
+
+if __name__ == "__main__":
+    main()
@@ -3,24 +3,91 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 
 #include "Actor.hpp"
+#include "Profiler.hpp"
+
+#include <Arduino.h>
 
 namespace Actor {
 
+DispatchStats dispatchStats;
+
 rtos::Mutex handlerMutex;
 
-void queueEventCallback(Actor *actor, Message *message) {
-  handlerMutex.lock();
+Scheduler scheduler(queueEventCallback);
+
+static SchedulerMode schedulerMode = SCHEDULER_THREADED;
+
+// the thread every actor runs on in cooperative mode, started with the first
+// actor
+static rtos::Thread *schedulerThread = nullptr;
+static rtos::EventFlags schedulerFlags;
+#define SCHEDULER_FLAG_POSTED 0x1
+
+static void runScheduler() {
+  while (true) {
+    if (!scheduler.runOnce()) {
+      schedulerFlags.wait_any(SCHEDULER_FLAG_POSTED);
+    }
+  }
+}
+
+void setSchedulerMode(SchedulerMode mode) {
+  schedulerMode = mode;
+}
+
+SchedulerMode getSchedulerMode() {
+  return schedulerMode;
+}
+
+uint32_t getThreadedBytesPerActor() {
+  return OS_STACK_SIZE + EVENTS_QUEUE_SIZE + sizeof(rtos::Thread)
+         + sizeof(events::EventQueue)
+         + sizeof(events::Event<void(Actor *, Message *, uint32_t)>);
+}
+
+void queueEventCallback(Actor *actor, Message *message, uint32_t postedAt) {
+  dispatchStats.record(micros() - postedAt);
+
+  // handlers already run one at a time on the cooperative scheduler's thread
+  rtos::Mutex *lock = nullptr;
+  if (schedulerMode == SCHEDULER_THREADED) {
+    lock = actor->getHandlerLock();
+  }
+  if (lock) {
+    lock->lock();
+  }
+
+  if (message->coalesce) {
+    // cleared before handling, so one more can queue up behind this one
+    core_util_critical_section_enter();
+    actor->pendingSignals &= ~signalMask(message->signal);
+    core_util_critical_section_exit();
+  }
+
+#ifdef KYWY_PROFILER
+  uint32_t profilerStart = Profiler::beginHandle(actor);
+#endif
+
   switch (message->directive) {
     case DIRECTIVE_HANDLE:
       actor->handle(message);
       break;
     case DIRECTIVE_EXIT:
       actor->teardown();
-      return;
+      break;
     default:
       break;
   }
-  handlerMutex.unlock();
+
+#ifdef KYWY_PROFILER
+  Profiler::endHandle(actor, message->signal, profilerStart, postedAt);
+#endif
+
+  if (lock) {
+    lock->unlock();
+  }
+
+  messagePool.release(message);
 };
 
 void Actor::initialize() {}
@@ -33,100 +100,257 @@ void Actor::disable() {
   enabled = false;
 };
 
-Actor::Actor() {
-  this->event_handler = new events::Event<void(Actor *, Message *)>(&this->queue, queueEventCallback);
-}
+void Actor::setHandlerLock(rtos::Mutex *lock) {
+  handlerLock = lock;
+};
+rtos::Mutex *Actor::getHandlerLock() {
+  return handlerLock;
+};
+
+Actor::Actor() {}
 
 Actor::~Actor() {
+  delete[] this->subscriptions;
   delete this->event_handler;
+  delete this->thread;
+  delete this->queue;
 }
 
 void Actor::start() {
+  if (schedulerMode == SCHEDULER_COOPERATIVE) {
+    initialize();
+    if (schedulerThread == nullptr) {
+      schedulerThread = new rtos::Thread();
+      schedulerThread->start(mbed::callback(runScheduler));
+    }
+    return;
+  }
+
+  allocateQueue();
   initialize();
-  thread.start(mbed::callback(&queue, &events::EventQueue::dispatch_forever));
+  thread->start(mbed::callback(queue, &events::EventQueue::dispatch_forever));
 }
 
-void Actor::dispatch(Message *message) {
+void Actor::allocateQueue() {
+  if (this->queue != nullptr) {
+    return;
+  }
+
+  this->queue = new events::EventQueue();
+  this->event_handler = new events::Event<void(Actor *, Message *, uint32_t)>(this->queue, queueEventCallback);
+  this->thread = new rtos::Thread();
+}
+
+bool Actor::post(Message *message) {
+  SignalMask coalesceSignal = 0;
+  if (message->coalesce) {
+    coalesceSignal = signalMask(message->signal);
+
+    core_util_critical_section_enter();
+    bool pending = pendingSignals & coalesceSignal;
+    pendingSignals |= coalesceSignal;
+    core_util_critical_section_exit();
+
+    if (pending) {
+      coalesced++;
+      dispatchStats.messagesCoalesced++;
+      return false;
+    }
+  }
+
+#ifdef KYWY_PROFILER
+  // counted before posting, the message may be handled before post returns
+  Profiler::posted(this);
+#endif
+
+  bool posted;
+
+  if (schedulerMode == SCHEDULER_COOPERATIVE) {
+    posted = scheduler.post(this, message, message->priority, micros());
+    if (posted) {
+      schedulerFlags.set(SCHEDULER_FLAG_POSTED);
+    }
+  } else {
+    // messages sent before the actor starts wait in its queue
+    allocateQueue();
+    posted = this->event_handler->post(this, message, micros()) != 0;
+  }
+
+  if (!posted && coalesceSignal) {
+    core_util_critical_section_enter();
+    pendingSignals &= ~coalesceSignal;
+    core_util_critical_section_exit();
+  }
+
+#ifdef KYWY_PROFILER
+  if (!posted) {
+    Profiler::unposted(this);
+  }
+#endif
+
+  return posted;
+}
+
+void Actor::dispatch(const Message &message) {
+  Message *pooled = messagePool.acquire(message, 1);
+  if (pooled == nullptr) {
+    return;  // pool exhausted, counted by the pool
+  }
+
   // user cannot dispatch special system directives
-  message->directive = DIRECTIVE_HANDLE;
-  this->event_handler->post(this, message);
+  pooled->directive = DIRECTIVE_HANDLE;
+  if (!post(pooled)) {
+    // TODO: error
+    messagePool.release(pooled);  // queue full or coalesced
+  }
+}
+
+void Actor::dispatch(Message *message) {
+  dispatch(*message);
 }
 
 void Actor::stop() {
-  Message message;
-  message.directive = DIRECTIVE_EXIT;
-  this->event_handler->post(this, &message);
+  // messages are posted by pointer so this can't live on the stack, every exit
+  // message is the same so one is shared between all actors
+  static Message exitMessage;
+  exitMessage.directive = DIRECTIVE_EXIT;
+  post(&exitMessage);
 }
 
-void Actor::addSubscriber(Actor *actor) {
+// A mask covering most signals, like SIGNAL_MASK_ALL or
+// `SIGNAL_MASK_ALL & ~signalMask(TICK)`, says which signals aren't wanted
+// rather than which are, so it doesn't name explicit signals even though
+// their bits are set
+static bool namesSignals(SignalMask signals) {
+  return __builtin_popcountll(signals) <= 32;
+}
+
+void Actor::addSubscriber(Actor *actor, SignalMask signals) {
   if (actor == this) {
     // TODO: error
     return;  // cannot subscribe to self
   }
 
-  uint8_t i = 0;
-  while (i < MAX_SUBSCRIBERS && subscribers[i] != nullptr) {
-    if (subscribers[i] == actor) {
-      // TODO: error
-      return;  // already subscribed
+  if (!namesSignals(signals)) {
+    signals &= ~explicitSignals;
+  }
+
+  subscriptionsMutex.lock();
+
+  for (uint8_t i = 0; i < numSubscriptions; i++) {
+    if (subscriptions[i].actor == actor) {
+      subscriptions[i].signals |= signals;  // already subscribed
+      subscriptionsMutex.unlock();
+      return;
     }
-    i++;
   }
 
-  if (i == MAX_SUBSCRIBERS) {
-    // TODO: error
-    return;  // subscriber limit reached
+  if (numSubscriptions == subscriptionsCapacity) {
+    if (subscriptionsCapacity > UINT8_MAX - SUBSCRIBERS_GROWTH) {
+      subscriptionsMutex.unlock();
+      // TODO: error
+      return;  // subscriber limit reached
+    }
+
+    // subscribing is rare (mostly during setup), grow a few entries at a time
+    Subscription *grown = new Subscription[subscriptionsCapacity + SUBSCRIBERS_GROWTH];
+    for (uint8_t i = 0; i < numSubscriptions; i++) {
+      grown[i] = subscriptions[i];
+    }
+    delete[] subscriptions;
+    subscriptions = grown;
+    subscriptionsCapacity += SUBSCRIBERS_GROWTH;
   }
 
-  subscribers[i] = actor;
+  subscriptions[numSubscriptions].actor = actor;
+  subscriptions[numSubscriptions].signals = signals;
+  numSubscriptions++;
+
+  subscriptionsMutex.unlock();
 }
 
-void Actor::subscribe(Actor *actor) {
-  actor->addSubscriber(this);
+void Actor::subscribe(Actor *actor, SignalMask signals) {
+  actor->addSubscriber(this, signals);
 }
 
-void Actor::removeSubscriber(Actor *actor) {
+void Actor::removeSubscriber(Actor *actor, SignalMask signals) {
   if (actor == this) {
     // TODO: error
     return;  // cannot unsubscribe from self
   }
 
+  subscriptionsMutex.lock();
+
   uint8_t i = 0;
   bool removed = false;
-  while (i < MAX_SUBSCRIBERS && subscribers[i] != nullptr) {
+  while (i < numSubscriptions) {
     if (removed) {
-      // shift remaining subscribers down so that `publish` calls don't have
-      // to iterate over the entire list, just the beginning populated section
-      subscribers[i - 1] = subscribers[i];
-      subscribers[i] = nullptr;
-    } else if (subscribers[i] == actor) {
-      subscribers[i] = nullptr;
-      removed = true;
+      // shift remaining subscribers down so that they're still published to
+      // in the order they subscribed
+      subscriptions[i - 1] = subscriptions[i];
+    } else if (subscriptions[i].actor == actor) {
+      subscriptions[i].signals &= ~signals;
+      removed = !subscriptions[i].signals;  // no signals left
     }
     i++;
   }
+
+  if (removed) {
+    numSubscriptions--;
+  }
+
+  subscriptionsMutex.unlock();
 }
 
-void Actor::unsubscribe(Actor *actor) {
-  actor->removeSubscriber(this);
+void Actor::unsubscribe(Actor *actor, SignalMask signals) {
+  actor->removeSubscriber(this, signals);
 }
 
-void Actor::publish(Message *message) {
-  uint8_t i = 0;
-  while (i < MAX_SUBSCRIBERS) {
+void Actor::publish(const Message &message) {
+  SignalMask signal = signalMask(message.signal);
 
-    if (subscribers[i] == nullptr) {
-      // reached end of subscriber list,
-      // no need to iterate over rest of nullptrs in the array
-      return;
+  // the publisher holds a reference while posting so the message can't be
+  // freed by a subscriber that handles it before the rest have been posted to
+  Message *pooled = nullptr;
+
+  subscriptionsMutex.lock();
+
+  for (uint8_t i = 0; i < numSubscriptions; i++) {
+    Actor *subscriber = subscriptions[i].actor;
+
+    if (!subscriber->enabled) {  // don't send events to disabled actors
+      continue;
     }
 
-    if (subscribers[i]->enabled) {  // don't send events to disabled actors
-      subscribers[i]->dispatch(message);
+    if (!(subscriptions[i].signals & signal)) {
+      dispatchStats.messagesFiltered++;
+      continue;
     }
 
-    i++;
+    if (pooled == nullptr) {
+      pooled = messagePool.acquire(message, 1);
+      if (pooled == nullptr) {
+        break;  // pool exhausted, counted by the pool
+      }
+      pooled->directive = DIRECTIVE_HANDLE;
+    }
+
+    messagePool.retain(pooled);
+    if (!subscriber->post(pooled)) {
+      // TODO: error
+      messagePool.release(pooled);  // queue full or coalesced
+    }
   }
+
+  subscriptionsMutex.unlock();
+
+  if (pooled != nullptr) {
+    messagePool.release(pooled);
+  }
+}
+
+void Actor::publish(Message *message) {
+  publish(*message);
 }
 
 }  // namespace Actor
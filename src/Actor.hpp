@@ -7,40 +7,87 @@
 
 #include "mbed.h"
 #include "EventQueue.h"
+#include "Message.hpp"
+#include "Scheduler.hpp"
 
 namespace Actor {
-const uint8_t MAX_SUBSCRIBERS = 5;
-
-typedef enum : uint8_t {
-  DIRECTIVE_HANDLE,
-  DIRECTIVE_EXIT,
-} Directive;
-
-struct Message {
-  Message()
-    : directive(DIRECTIVE_HANDLE), signal(0), data(nullptr) {}
-  Message(int signal)
-    : directive(DIRECTIVE_HANDLE), signal(signal), data(nullptr) {}
-  Message(int signal, void *data)
-    : directive(DIRECTIVE_HANDLE), signal(signal), data(data) {}
-  Directive directive;
-  int signal;
-  void *data;
+
+// subscriber tables grow by this many entries at a time
+#define SUBSCRIBERS_GROWTH 4
+
+// time between a message being dispatched and the actor starting to handle it,
+// in microseconds, across all actors (not locked, so only approximate while
+// actors without a handler lock are running)
+struct DispatchStats {
+  uint32_t messagesHandled = 0;
+  uint32_t messagesFiltered = 0;  // published messages a subscriber's signal mask skipped
+  uint32_t messagesCoalesced = 0;  // dropped because the same signal was already waiting, see `Message::coalesce`
+  uint32_t maxLatency = 0;
+  uint64_t totalLatency = 0;
+
+  void record(uint32_t latency) {
+    messagesHandled++;
+    totalLatency += latency;
+    maxLatency = latency > maxLatency ? latency : maxLatency;
+  };
+  uint32_t getAverageLatency() {
+    return messagesHandled ? totalLatency / messagesHandled : 0;
+  };
 };
 
-extern rtos::Mutex handlerMutex;  // mutex to lock so that handler functions run from start to finish before going to another actor.
+extern DispatchStats dispatchStats;
+
+extern rtos::Mutex handlerMutex;  // default handler lock, so that handler functions run from start to finish before going to another actor.
+
+extern Scheduler scheduler;  // only used in cooperative mode
+
+// Pick how actors are run, has to be called before any actor is started. In
+// cooperative mode actors don't get their own thread or event queue, saving
+// `getThreadedBytesPerActor` bytes of RAM each, and are all run from one
+// thread that handles messages in priority order.
+void setSchedulerMode(SchedulerMode mode);
+SchedulerMode getSchedulerMode();
+
+// RAM a started actor allocates in threaded mode for its thread's stack and
+// its event queue
+uint32_t getThreadedBytesPerActor();
 
 class Actor {
 private:
-  rtos::Thread thread;
-  events::EventQueue queue;
-  events::Event<void(Actor *, Message *)> *event_handler;
-
-  Actor *subscribers[MAX_SUBSCRIBERS] = {};
+  // only allocated in threaded mode
+  rtos::Thread *thread = nullptr;
+  events::EventQueue *queue = nullptr;
+  events::Event<void(Actor *, Message *, uint32_t)> *event_handler = nullptr;
+
+  struct Subscription {
+    Actor *actor;
+    SignalMask signals;
+  };
+
+  // in the order actors subscribed, which is the order they're published to
+  Subscription *subscriptions = nullptr;
+  uint8_t numSubscriptions = 0;
+  uint8_t subscriptionsCapacity = 0;
+  rtos::Mutex subscriptionsMutex;
 
   // used to control scenes (clusters of actors)
   bool enabled = true;
 
+  rtos::Mutex *handlerLock = &handlerMutex;
+
+  // published only to subscribers that ask for them by name, see
+  // `setExplicitSignals`
+  SignalMask explicitSignals = 0;
+
+  // coalesced signals waiting in this actor's queue
+  volatile SignalMask pendingSignals = 0;
+  uint32_t coalesced = 0;
+
+  void allocateQueue();
+  bool post(Message *message);
+
+  friend void queueEventCallback(Actor *actor, Message *message, uint32_t postedAt);
+
 public:
   Actor();
   ~Actor();
@@ -53,20 +100,62 @@ public:
   virtual void initialize();
   virtual void teardown();
 
+  // shown by debug tools like the profiler, nullptr if unnamed
+  virtual const char *getName() {
+    return nullptr;
+  };
+
   void enable();
   void disable();
 
+  // Lock held while this actor handles a message. By default every actor
+  // shares `handlerMutex` and runs one at a time. Actors that only share state
+  // with each other can share their own lock, and actors that share no state
+  // at all can pass nullptr to run in parallel with everyone else (lock any
+  // shared resources like the display yourself, see `Display::lock`). Looking
+  // up glyphs, e.g. with `getTextSize`, is safe from any thread.
+  void setHandlerLock(rtos::Mutex *lock);
+  rtos::Mutex *getHandlerLock();
+
+  // messages dropped because one with the same signal was already waiting to
+  // be handled, see `Message::coalesce`
+  uint32_t getCoalesced() {
+    return coalesced;
+  };
+
+  // Messages are copied into `messagePool` when they're sent, so they don't
+  // need to outlive the call. Messages are dropped if the pool is empty.
+  void dispatch(const Message &message);
   void dispatch(Message *message);
+  void publish(const Message &message);
   void publish(Message *message);
 
-  void subscribe(Actor *actor);
-  void addSubscriber(Actor *actor);
-  void unsubscribe(Actor *actor);
-  void removeSubscriber(Actor *actor);
+  // Subscribe to the messages `actor` publishes, optionally only the ones
+  // with a signal in `signals`, e.g.
+  //   subscribe(&engine.input, ::Actor::signalMask(Kywy::Events::D_PAD_CENTER_PRESSED));
+  // Other messages are skipped before they're queued. Subscribing again adds
+  // to the signals. The publisher's explicit signals (see
+  // `setExplicitSignals`) are only included when named in `signals`, a mask
+  // with more than half of its bits set (e.g. `SIGNAL_MASK_ALL & ~mask`)
+  // leaves them out, subscribe again naming them to get them too.
+  void subscribe(Actor *actor, SignalMask signals = SIGNAL_MASK_ALL);
+  void addSubscriber(Actor *actor, SignalMask signals = SIGNAL_MASK_ALL);
+
+  // Signals this actor publishes that subscribing with SIGNAL_MASK_ALL (or any
+  // other mask that doesn't name them, see `subscribe`) doesn't include, for
+  // messages most subscribers don't want, e.g. INPUT_STATE. Call before
+  // anything subscribes.
+  void setExplicitSignals(SignalMask signals) {
+    explicitSignals = signals;
+  };
+
+  // stop getting `signals` from `actor`, or everything when left out
+  void unsubscribe(Actor *actor, SignalMask signals = SIGNAL_MASK_ALL);
+  void removeSubscriber(Actor *actor, SignalMask signals = SIGNAL_MASK_ALL);
 };
 
 // Queue event callback that handles events, or passes them to a user defined function to handle
-void queueEventCallback(Actor *actor, Message *message);
+void queueEventCallback(Actor *actor, Message *message, uint32_t postedAt);
 
 }  // namespace Actor
 
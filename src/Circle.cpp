@@ -3,153 +3,221 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 
 #include "Display.hpp"
+#include "Profiler.hpp"
 
 namespace Display {
 
-void Display::drawCircleWithEvenDiameterFromTopLeftCorner(int16_t x, int16_t y,
-                                                          uint16_t diameter,
-                                                          uint16_t color,
-                                                          bool fill) {
-  int16_t radius = diameter / 2;
-  int16_t xOffset = 0, yOffset = -radius + 1;
+// spans handed to the driver at a time
+#define SPAN_WRITER_BATCH 32
 
-  int16_t xTopLeftCenter = x + radius - 1, yTopLeftCenter = y + radius - 1;
-  int16_t xTopRightCenter = x + radius - 0, yTopRightCenter = y + radius - 1;
-  int16_t xBottomLeftCenter = x + radius - 1,
-          yBottomLeftCenter = y + radius - 0;
-  int16_t xBottomRightCenter = x + radius - 0,
-          yBottomRightCenter = y + radius - 0;
+// Round shapes are rasterized one quadrant at a time and written as spans,
+// each pixel exactly once. A row `k` rows out from the center is mirrored
+// above `top` and below `bottom`, and its pixels from `inner` to `outer`
+// columns out are mirrored left of `left` and right of `right`. Shapes with an
+// even width or height, and rounded rectangles, have those centers apart.
+class Display::SpanWriter {
+public:
+  // outlines are drawn with the color of `drawPixel`, fills with the color of
+  // `fillRectangle`
+  SpanWriter(Driver::Driver *driver, uint16_t color, bool fill)
+    : driver(driver), color(fill ? color : (color ? 0xff : 0x00)), fill(fill) {}
+  ~SpanWriter() {
+    flush();
+  };
 
-  int16_t discriminatorThreshold;
-  if (radius <= 3) {
-    discriminatorThreshold = 0;
-  } else if (radius <= 6) {
-    discriminatorThreshold = 3;
-  } else {
-    discriminatorThreshold = 5;
-  }
+  void setCenters(int16_t left, int16_t top, int16_t right, int16_t bottom) {
+    this->left = left;
+    this->top = top;
+    this->right = right;
+    this->bottom = bottom;
+  };
 
-  while (xOffset <= (-1 * yOffset)) {
-    // leverage 8-way symmetry
-
-    if (fill) {
-      driver->setBufferBlock(xTopLeftCenter - xOffset, yTopLeftCenter + yOffset,
-                             2 * (abs(xOffset) + 1), 1, color);
-      driver->setBufferBlock(xTopLeftCenter + yOffset, yTopLeftCenter - xOffset,
-                             2 * (abs(yOffset) + 1), 1, color);
-      driver->setBufferBlock(xBottomLeftCenter - xOffset,
-                             yBottomLeftCenter - yOffset,
-                             2 * (abs(xOffset) + 1), 1, color);
-      driver->setBufferBlock(xBottomLeftCenter + yOffset,
-                             yBottomLeftCenter + xOffset,
-                             2 * (abs(yOffset) + 1), 1, color);
-    } else {
-      // top left quadrant
-      driver->setBufferPixel(xTopLeftCenter - xOffset, yTopLeftCenter + yOffset,
-                             color);
-      driver->setBufferPixel(xTopLeftCenter + yOffset, yTopLeftCenter - xOffset,
-                             color);
-
-      // top right quadrant
-      driver->setBufferPixel(xTopRightCenter + xOffset,
-                             yTopRightCenter + yOffset, color);
-      driver->setBufferPixel(xTopRightCenter - yOffset,
-                             yTopRightCenter - xOffset, color);
-
-      // bottom left quadrant
-      driver->setBufferPixel(xBottomLeftCenter - xOffset,
-                             yBottomLeftCenter - yOffset, color);
-      driver->setBufferPixel(xBottomLeftCenter + yOffset,
-                             yBottomLeftCenter + xOffset, color);
-
-      // bottom right quadrant
-      driver->setBufferPixel(xBottomRightCenter + xOffset,
-                             yBottomRightCenter - yOffset, color);
-      driver->setBufferPixel(xBottomRightCenter - yOffset,
-                             yBottomRightCenter + xOffset, color);
+  // only draw the pixels counterclockwise from `start` up to `end`
+  void setArc(FixedPoint::Angle start, FixedPoint::Angle end) {
+    if (start == end) {
+      return;  // the whole outline
     }
 
-    xOffset++;
+    arc = true;
+    wide = (FixedPoint::Angle)(end - start) > ANGLE_HALF_TURN;
+    startX = FixedPoint::cos(start);
+    startY = FixedPoint::sin(start);
+    endX = FixedPoint::cos(end);
+    endY = FixedPoint::sin(end);
+  };
 
-    int16_t discriminator = (xOffset * xOffset) + (yOffset * yOffset) - ((radius - 1) * (radius - 1));
-    if (discriminator > discriminatorThreshold) {
-      yOffset++;
+  void row(int16_t k, int16_t inner, int16_t outer) {
+    int16_t upper = top - k, lower = bottom + k;
+
+    // the row through the top or bottom joins the two sides
+    if (fill || inner == 0) {
+      span(left - outer, right + outer, upper);
+      if (lower != upper)
+        span(left - outer, right + outer, lower);
+      return;
     }
-  }
-};
 
-void Display::drawCircleWithOddDiameterFromCenter(int16_t x, int16_t y,
-                                                  uint16_t diameter,
-                                                  uint16_t color, bool fill) {
-  int16_t radius = diameter / 2;
-  int16_t xOffset = 0, yOffset = -radius;
+    span(left - outer, left - inner, upper);
+    span(right + inner, right + outer, upper);
+    if (lower != upper) {
+      span(left - outer, left - inner, lower);
+      span(right + inner, right + outer, lower);
+    }
+  };
 
-  int16_t discriminatorThreshold;
-  switch (radius) {
-    case 1:
-      discriminatorThreshold = 0;
-      break;
-    case 2:
-      discriminatorThreshold = 1;
-      break;
-    case 3:
-      discriminatorThreshold = 3;
-      break;
-    default:
-      discriminatorThreshold = 5;
-  }
+  // the rows between the top and bottom centers, `outer` columns out
+  void middle(int16_t outer) {
+    for (int16_t y = top + 1; y < bottom; y++) {
+      if (fill || left - outer == right + outer) {
+        span(left - outer, right + outer, y);
+      } else {
+        span(left - outer, left - outer, y);
+        span(right + outer, right + outer, y);
+      }
+    }
+  };
 
-  while (xOffset <= (-1 * yOffset)) {
+  void span(int16_t spanLeft, int16_t spanRight, int16_t y) {
+    if (!arc) {
+      add(spanLeft, spanRight, y);
+      return;
+    }
 
-    if (fill) {
-      driver->setBufferBlock(x - xOffset, y + yOffset, 2 * abs(xOffset) + 1, 1,
-                             color);
-      driver->setBufferBlock(x + yOffset, y - xOffset, 2 * abs(yOffset) + 1, 1,
-                             color);
-      driver->setBufferBlock(x - xOffset, y - yOffset, 2 * abs(xOffset) + 1, 1,
-                             color);
-      driver->setBufferBlock(x + yOffset, y + xOffset, 2 * abs(yOffset) + 1, 1,
-                             color);
+    // outline spans are short, so the sweep is checked pixel by pixel
+    int16_t runLeft = spanLeft;
+    for (int16_t x = spanLeft; x <= spanRight; x++) {
+      if (!inArc(x, y)) {
+        if (runLeft < x)
+          add(runLeft, x - 1, y);
+        runLeft = x + 1;
+      }
+    }
+    if (runLeft <= spanRight)
+      add(runLeft, spanRight, y);
+  };
 
-    } else {
-      // leverage 8-way symmetry
-      driver->setBufferPixel(x + xOffset, y + yOffset, color);
-      driver->setBufferPixel(x + xOffset, y - yOffset, color);
-      driver->setBufferPixel(x - xOffset, y + yOffset, color);
-      driver->setBufferPixel(x - xOffset, y - yOffset, color);
-      driver->setBufferPixel(x + yOffset, y + xOffset, color);
-      driver->setBufferPixel(x + yOffset, y - xOffset, color);
-      driver->setBufferPixel(x - yOffset, y + xOffset, color);
-      driver->setBufferPixel(x - yOffset, y - xOffset, color);
+  void flush() {
+    if (numSpans) {
+      driver->setBufferSpans(spans, numSpans, color);
+      numSpans = 0;
+    }
+  };
+
+private:
+  Driver::Driver *driver;
+  uint16_t color;
+  bool fill;
+
+  int16_t left = 0, top = 0, right = 0, bottom = 0;
+
+  bool arc = false;
+  bool wide = false;  // sweeps more than half a turn
+  FixedPoint::Fixed startX = 0, startY = 0, endX = 0, endY = 0;
+
+  Span spans[SPAN_WRITER_BATCH];
+  uint8_t numSpans = 0;
+
+  void add(int16_t spanLeft, int16_t spanRight, int16_t y) {
+    if (numSpans == SPAN_WRITER_BATCH)
+      flush();
+    spans[numSpans++] = Span{ spanLeft, spanRight, y };
+  };
+
+  // measured from the middle of the shape in half pixels, with y pointing up
+  bool inArc(int16_t x, int16_t y) {
+    int32_t dX = 2 * x - (left + right), dY = (top + bottom) - 2 * y;
+    bool afterStart = (int64_t)startX * dY - (int64_t)startY * dX >= 0;
+    bool beforeEnd = (int64_t)endX * dY - (int64_t)endY * dX <= 0;
+    return wide ? afterStart || beforeEnd : afterStart && beforeEnd;
+  };
+};
+
+// Walks the octant from the top of a circle down to 45 degrees, `radius`
+// pixels from the center. Each step moves a column out and moves a row in
+// once the step is far enough outside the circle, how far is `threshold`,
+// tuned by hand for small circles. The steps on one row are that row's span,
+// and mirrored across the diagonal each step is a single pixel of a row in
+// the other octant.
+void Display::rasterizeCircle(SpanWriter &writer, int16_t radius,
+                              int16_t threshold) {
+  int16_t xOffset = 0, yOffset = -radius;
+  int16_t rowStart = 0;  // first step on the current row
+
+  while (xOffset <= (-1 * yOffset)) {
+    // the pixel on the diagonal is part of this octant's row
+    if (xOffset != -yOffset) {
+      writer.row(xOffset, -yOffset, -yOffset);
     }
+
     xOffset++;
 
     int16_t discriminator =
       (xOffset * xOffset) + (yOffset * yOffset) - (radius * radius);
-    if (discriminator > discriminatorThreshold) {
+    if (discriminator > threshold) {
+      writer.row(-yOffset, rowStart, xOffset - 1);
+      rowStart = xOffset;
       yOffset++;
     }
   }
-};
+
+  if (rowStart < xOffset) {
+    writer.row(-yOffset, rowStart, xOffset - 1);
+  }
+}
+
+// Row by row from the middle out, each row reaches the furthest column whose
+// center is inside the ellipse. Outlines also cover the columns up to the next
+// row's edge, so the outline has no gaps.
+void Display::rasterizeEllipse(SpanWriter &writer, uint16_t width,
+                               uint16_t height) {
+  // in half pixels from the center, where pixel centers of even sizes are
+  // odd, and the ellipse is inside where
+  //   x^2 * height^2 <= width^2 * (height^2 - y^2)
+  uint64_t widthSquared = (uint64_t)width * width,
+           heightSquared = (uint64_t)height * height;
+  uint8_t xShift = 1 - width % 2, yShift = 1 - height % 2;
+
+  int16_t rows = (height - 1) / 2;
+  int32_t column = (width - 1) / 2;
+
+  int16_t outer = 0;
+  for (int16_t k = 0; k <= rows + 1; k++) {
+    int16_t rowOuter = -1;
+    if (k <= rows) {
+      uint64_t y = 2 * k + yShift;
+      uint64_t limit = widthSquared * (heightSquared - y * y);
+      while (column > 0 && (uint64_t)(2 * column + xShift) * (2 * column + xShift) * heightSquared > limit) {
+        column--;
+      }
+      rowOuter = column;
+    }
+
+    if (k > 0) {
+      int16_t inner = rowOuter + 1 < outer ? rowOuter + 1 : outer;
+      writer.row(k - 1, inner, outer);  // the last row's inner is 0 and joins the sides
+    }
+    outer = rowOuter;
+  }
+}
 
 void Display::drawOrFillCircle(Origin::Object2D origin, int16_t x, int16_t y,
-                               uint16_t diameter, uint16_t color, bool fill) {
+                               uint16_t diameter, SpanWriter &writer) {
+  int16_t radius = diameter / 2;
+
+  // top left corner of the circle
   if (diameter % 2 == 0) {  // even diameter
     switch (origin) {
       case Origin::Object2D::TOP_LEFT:
-        drawCircleWithEvenDiameterFromTopLeftCorner(x, y, diameter, color, fill);
         break;
       case Origin::Object2D::TOP_RIGHT:
-        drawCircleWithEvenDiameterFromTopLeftCorner(x - diameter, y, diameter,
-                                                    color, fill);
+        x -= diameter;
         break;
       case Origin::Object2D::BOTTOM_LEFT:
-        drawCircleWithEvenDiameterFromTopLeftCorner(x, y - diameter, diameter,
-                                                    color, fill);
+        y -= diameter;
         break;
       case Origin::Object2D::BOTTOM_RIGHT:
-        drawCircleWithEvenDiameterFromTopLeftCorner(x - diameter, y - diameter,
-                                                    diameter, color, fill);
+        x -= diameter;
+        y -= diameter;
         break;
       case Origin::Object2D::CENTER:
         // Since there is no pixel center of an even diameter circle we bias to
@@ -173,45 +241,162 @@ void Display::drawOrFillCircle(Origin::Object2D origin, int16_t x, int16_t y,
         // ### #### ###
         // ####    ####
         // ############
-        drawCircleWithEvenDiameterFromTopLeftCorner(
-          x - (diameter / 2), y - (diameter / 2), diameter, color, fill);
+        x -= diameter / 2;
+        y -= diameter / 2;
         break;
     }
+
+    int16_t discriminatorThreshold;
+    if (radius <= 3) {
+      discriminatorThreshold = 0;
+    } else if (radius <= 6) {
+      discriminatorThreshold = 3;
+    } else {
+      discriminatorThreshold = 5;
+    }
+
+    // a quadrant around each of the four middle pixels
+    writer.setCenters(x + radius - 1, y + radius - 1, x + radius, y + radius);
+    rasterizeCircle(writer, radius - 1, discriminatorThreshold);
   } else {  // odd diameter
     switch (origin) {
       case Origin::Object2D::TOP_LEFT:
-        drawCircleWithOddDiameterFromCenter(
-          x + (diameter / 2), y + (diameter / 2), diameter, color, fill);
         break;
       case Origin::Object2D::TOP_RIGHT:
-        drawCircleWithOddDiameterFromCenter(
-          x - (diameter / 2), y + (diameter / 2), diameter, color, fill);
+        x -= 2 * radius;
         break;
       case Origin::Object2D::BOTTOM_LEFT:
-        drawCircleWithOddDiameterFromCenter(
-          x + (diameter / 2), y - (diameter / 2), diameter, color, fill);
+        y -= 2 * radius;
         break;
       case Origin::Object2D::BOTTOM_RIGHT:
-        drawCircleWithOddDiameterFromCenter(
-          x - (diameter / 2), y - (diameter / 2), diameter, color, fill);
+        x -= 2 * radius;
+        y -= 2 * radius;
         break;
       case Origin::Object2D::CENTER:
-        drawCircleWithOddDiameterFromCenter(x, y, diameter, color, fill);
+        x -= radius;
+        y -= radius;
+        break;
+    }
+
+    int16_t discriminatorThreshold;
+    switch (radius) {
+      case 1:
+        discriminatorThreshold = 0;
         break;
+      case 2:
+        discriminatorThreshold = 1;
+        break;
+      case 3:
+        discriminatorThreshold = 3;
+        break;
+      default:
+        discriminatorThreshold = 5;
     }
+
+    writer.setCenters(x + radius, y + radius, x + radius, y + radius);
+    rasterizeCircle(writer, radius, discriminatorThreshold);
   }
 };
 
 void Display::drawCircle(int16_t x, int16_t y, uint16_t diameter,
                          Object2DOptions options) {
-  drawOrFillCircle(options.getOrigin(), x, y, diameter, options.getColor(),
-                   false);
+  PROFILE_SCOPE(::Profiler::RECORD_DRAW, ::Profiler::DRAW_CIRCLE);
+  SpanWriter writer(driver, options.getColor(), false);
+  drawOrFillCircle(options.getOrigin(), x, y, diameter, writer);
 }
 
 void Display::fillCircle(int16_t x, int16_t y, uint16_t diameter,
                          Object2DOptions options) {
-  drawOrFillCircle(options.getOrigin(), x, y, diameter, options.getColor(),
-                   true);
+  PROFILE_SCOPE(::Profiler::RECORD_DRAW, ::Profiler::FILL_CIRCLE);
+  SpanWriter writer(driver, options.getColor(), true);
+  drawOrFillCircle(options.getOrigin(), x, y, diameter, writer);
+}
+
+void Display::drawArc(int16_t x, int16_t y, uint16_t diameter,
+                      FixedPoint::Angle start, FixedPoint::Angle end,
+                      Object2DOptions options) {
+  PROFILE_SCOPE(::Profiler::RECORD_DRAW, ::Profiler::DRAW_ARC);
+  SpanWriter writer(driver, options.getColor(), false);
+  writer.setArc(start, end);
+  drawOrFillCircle(options.getOrigin(), x, y, diameter, writer);
+}
+
+void Display::drawEllipse(int16_t x, int16_t y, uint16_t width,
+                          uint16_t height, Object2DOptions options) {
+  PROFILE_SCOPE(::Profiler::RECORD_DRAW, ::Profiler::DRAW_ELLIPSE);
+  if (!width || !height)
+    return;
+
+  shiftOrigin2DToTopLeft(options.getOrigin(), x, y, width, height);
+  SpanWriter writer(driver, options.getColor(), false);
+  writer.setCenters(x + (width - 1) / 2, y + (height - 1) / 2, x + width / 2,
+                    y + height / 2);
+  rasterizeEllipse(writer, width, height);
+}
+
+void Display::fillEllipse(int16_t x, int16_t y, uint16_t width,
+                          uint16_t height, Object2DOptions options) {
+  PROFILE_SCOPE(::Profiler::RECORD_DRAW, ::Profiler::FILL_ELLIPSE);
+  if (!width || !height)
+    return;
+
+  shiftOrigin2DToTopLeft(options.getOrigin(), x, y, width, height);
+  SpanWriter writer(driver, options.getColor(), true);
+  writer.setCenters(x + (width - 1) / 2, y + (height - 1) / 2, x + width / 2,
+                    y + height / 2);
+  rasterizeEllipse(writer, width, height);
+}
+
+// the corners are the quadrants of an even diameter circle pulled apart to
+// the corners of the rectangle
+void Display::rasterizeRoundedRectangle(SpanWriter &writer, int16_t x,
+                                        int16_t y, uint16_t width,
+                                        uint16_t height, uint16_t radius) {
+  if (!width || !height)
+    return;
+
+  uint16_t shorter = width < height ? width : height;
+  if (radius > shorter / 2)
+    radius = shorter / 2;
+
+  if (radius == 0) {
+    writer.setCenters(x, y, x + width - 1, y + height - 1);
+    writer.row(0, 0, 0);
+    writer.middle(0);
+    return;
+  }
+
+  int16_t discriminatorThreshold;
+  if (radius <= 3) {
+    discriminatorThreshold = 0;
+  } else if (radius <= 6) {
+    discriminatorThreshold = 3;
+  } else {
+    discriminatorThreshold = 5;
+  }
+
+  writer.setCenters(x + radius - 1, y + radius - 1, x + width - radius,
+                    y + height - radius);
+  rasterizeCircle(writer, radius - 1, discriminatorThreshold);
+  writer.middle(radius - 1);
+}
+
+void Display::drawRoundedRectangle(int16_t x, int16_t y, uint16_t width,
+                                   uint16_t height, uint16_t radius,
+                                   Object2DOptions options) {
+  PROFILE_SCOPE(::Profiler::RECORD_DRAW, ::Profiler::DRAW_ROUNDED_RECTANGLE);
+  shiftOrigin2DToTopLeft(options.getOrigin(), x, y, width, height);
+  SpanWriter writer(driver, options.getColor(), false);
+  rasterizeRoundedRectangle(writer, x, y, width, height, radius);
+}
+
+void Display::fillRoundedRectangle(int16_t x, int16_t y, uint16_t width,
+                                   uint16_t height, uint16_t radius,
+                                   Object2DOptions options) {
+  PROFILE_SCOPE(::Profiler::RECORD_DRAW, ::Profiler::FILL_ROUNDED_RECTANGLE);
+  shiftOrigin2DToTopLeft(options.getOrigin(), x, y, width, height);
+  SpanWriter writer(driver, options.getColor(), true);
+  rasterizeRoundedRectangle(writer, x, y, width, height, radius);
 }
 
 }  // namespace Display
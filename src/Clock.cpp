@@ -8,36 +8,158 @@
 namespace Kywy {
 
 void clockTickCallback(Clock *clock) {
-  if (clock->options.getClickToClick()) {
-    if (Serial.available()) {
-      String input = Serial.readString();
-      if (!(input == "tick\n")) {
-        return;
-      }
-    } else {
+  uint64_t now = clock->updateTime();
+  uint64_t due = clock->nextTickAt;
+  uint32_t duration = clock->tickDuration.count() * 1000;
+
+  // ticks that came due after this one while we were late
+  uint32_t behind = now > due ? (now - due) / duration : 0;
+  clock->nextTickAt = due + (uint64_t)(behind + 1) * duration;
+  clock->scheduleTick();
+
+  clock->stats.record(now > due ? now - due : due - now);
+  if (behind) {
+    clock->stats.overruns++;
+  }
+
+  if (clock->paused) {
+    if (!clock->steps) {
       return;
     }
+    core_util_atomic_decr_u16(&clock->steps, 1);
+    behind = 0;  // waiting to be stepped isn't falling behind
   }
 
-  clock->publish(&clock->tickMessage);
+  if (clock->options.getFixedTimestep()) {
+    // drop the oldest missed ticks and publish the rest
+    uint32_t catchUp = behind < clock->options.getMaxCatchUpTicks()
+                         ? behind
+                         : clock->options.getMaxCatchUpTicks();
+    uint32_t skipped = behind - catchUp;
+    clock->stats.skipped += skipped;
+
+    for (uint32_t i = skipped; i <= behind; i++) {
+      clock->publishTick(due + (uint64_t)i * duration, duration,
+                         i == skipped ? skipped : 0);
+    }
+  } else {
+    clock->stats.skipped += behind;
+    clock->publishTick(now, now - clock->lastTickAt, behind);
+  }
 };
 
+// runs on the clock thread so the pending tick can be moved safely
+void clockSetTickDurationCallback(Clock *clock, int milliseconds) {
+  clock->tickDuration = std::chrono::milliseconds(milliseconds);
+  if (clock->stepping) {
+    return;  // no pending tick while free running
+  }
+
+  // the next tick is one new tick duration after the last one
+  uint64_t now = clock->updateTime();
+  uint64_t due = clock->lastTickAt + milliseconds * 1000;
+  clock->nextTickAt = due > now ? due : now;
+
+  clock->clock.cancel(clock->tickEvent);
+  clock->scheduleTick();
+}
+
+void clockSetFreeRunningCallback(Clock *clock, bool freeRunning) {
+  clock->freeRunning = freeRunning;
+
+  if (freeRunning && !clock->stepping) {
+    // the clock actor publishes ticks until free running is turned off
+    clock->clock.cancel(clock->tickEvent);
+    clock->stepping = true;
+    clock->dispatchStep();
+  }
+}
+
+// runs after the clock actor stopped stepping, `stepping` stays set until
+// here so turning free running back on in the meantime doesn't start a
+// second chain of steps
+void clockResumeCallback(Clock *clock) {
+  if (clock->freeRunning) {
+    // turned back on in the meantime, carry on stepping
+    clock->dispatchStep();
+    return;
+  }
+  clock->stepping = false;
+
+  // free running ticks move time ahead of the real clock, keep it monotonic
+  uint64_t now = clock->updateTime();
+  clock->time = now > clock->lastTickAt ? now : clock->lastTickAt;
+  clock->nextTickAt = clock->time + clock->tickDuration.count() * 1000;
+  clock->scheduleTick();
+}
+
+// extends micros(), which wraps every ~71 minutes
+uint64_t Clock::updateTime() {
+  uint32_t now = micros();
+  time += now - lastMicros;
+  lastMicros = now;
+  return time;
+}
+
+void Clock::scheduleTick() {
+  uint64_t now = updateTime();
+  uint32_t delay = nextTickAt > now ? nextTickAt - now : 0;
+
+  // the queue counts milliseconds, round to the closest one
+  tickEvent = clock.call_in(std::chrono::milliseconds((delay + 500) / 1000),
+                            mbed::callback(&clockTickCallback, this));
+}
+
+// low priority so that on the cooperative scheduler everything the last tick
+// caused is handled first
+void Clock::dispatchStep() {
+  dispatch(::Actor::Message(Events::CLOCK_STEP, nullptr, ::Actor::PRIORITY_LOW));
+}
+
+void Clock::publishTick(uint64_t at, uint32_t elapsed, uint16_t skipped) {
+  Tick tick = { frame++, (uint32_t)(at / 1000), elapsed, skipped };
+  tickMessage.setPayload(tick);
+  // an actor that is still busy with a tick doesn't need the ones it missed,
+  // it can tell how many from the frame number, but with a fixed timestep
+  // every tick (catch-up ticks included) has to be handled
+  tickMessage.coalesce = !options.getFixedTimestep();
+  lastTickAt = at;
+  publish(tickMessage);
+}
+
 int Clock::getTickDuration() {
   return tickDuration.count();
 }
 
 void Clock::setTickDuration(int milliseconds) {
-  tickDuration = std::chrono::milliseconds(milliseconds);
-  // TODO: this is still broken
-  // this->clock.break_dispatch();
-  // this->clock.call_every(tickDuration, mbed::callback(&clockTickCallback,
-  // this));
+  if (milliseconds <= 0) {
+    // TODO: error
+    return;
+  }
+
+  clock.call(&clockSetTickDurationCallback, this, milliseconds);
+}
+
+void Clock::setFreeRunning(bool freeRunning) {
+  clock.call(&clockSetFreeRunningCallback, this, freeRunning);
+}
+
+void Clock::setPaused(bool paused) {
+  steps = 0;
+  this->paused = paused;
+}
+
+void Clock::step(uint16_t ticks) {
+  core_util_atomic_incr_u16(&steps, ticks);
 }
 
 void Clock::initialize() {
   this->tickMessage.signal = Kywy::Events::TICK;
-  this->clock.call_every(tickDuration,
-                         mbed::callback(&clockTickCallback, this));
+  paused = options.getClickToClick();
+
+  lastMicros = micros();
+  nextTickAt = tickDuration.count() * 1000;
+  scheduleTick();
   clockThread.start(
     mbed::callback(&(this->clock), &events::EventQueue::dispatch_forever));
 }
@@ -49,6 +171,19 @@ void Clock::handle(::Actor::Message *message) {
         setTickDuration(*(int *)message->data);
         break;
       }
+    case Events::CLOCK_STEP:
+      {
+        if (!freeRunning) {
+          // the clock thread decides whether to resume ticking
+          clock.call(&clockResumeCallback, this);
+          break;
+        }
+
+        uint32_t duration = tickDuration.count() * 1000;
+        publishTick(lastTickAt + duration, duration, 0);
+        dispatchStep();
+        break;
+      }
     default:
       {
         break;
@@ -13,7 +13,11 @@ namespace Kywy {
 
 struct ClockOptions {
   bool _clickToTick = false;
+  bool _fixedTimestep = false;
+  uint8_t _maxCatchUpTicks = 2;
 
+  // start paused, ticks are then sent with the console's `tick` command (see
+  // `Console`)
   ClockOptions clickToTick(bool setClickToTick) {
     _clickToTick = setClickToTick;
     return *this;
@@ -21,6 +25,58 @@ struct ClockOptions {
   bool getClickToClick() {
     return _clickToTick;
   };
+
+  // every tick reports exactly one tick duration as elapsed, and ticks missed
+  // while the clock was behind are published back to back (up to
+  // `maxCatchUpTicks`) instead of only being counted as skipped. Ticks don't
+  // coalesce, every actor handles every one of them, so handlers have to keep
+  // up with the tick duration on average or their queues fill up.
+  ClockOptions fixedTimestep(bool setFixedTimestep) {
+    _fixedTimestep = setFixedTimestep;
+    return *this;
+  };
+  bool getFixedTimestep() {
+    return _fixedTimestep;
+  };
+
+  ClockOptions maxCatchUpTicks(uint8_t setMaxCatchUpTicks) {
+    _maxCatchUpTicks = setMaxCatchUpTicks;
+    return *this;
+  };
+  uint8_t getMaxCatchUpTicks() {
+    return _maxCatchUpTicks;
+  };
+};
+
+// Payload of every TICK, read with `message->getPayload<Kywy::Tick>()`. Unless
+// the clock has a fixed timestep TICKs coalesce, an actor still handling one
+// when the next is published doesn't get it (see `Message::coalesce`) and sees
+// a gap in `frame`, use `time` to measure how long it has been since the last
+// one it handled.
+struct Tick {
+  uint32_t frame;    // ticks published before this one
+  uint32_t time;     // milliseconds since the clock started
+  uint32_t elapsed;  // microseconds since the previous tick
+  uint16_t skipped;  // ticks dropped right before this one because the clock fell behind
+};
+
+// how far off schedule ticks were published, in microseconds (not locked, so
+// only approximate while the clock is running)
+struct ClockStats {
+  uint32_t ticks = 0;     // times the clock woke up to tick
+  uint32_t overruns = 0;  // ticks published a whole tick duration or more late
+  uint32_t skipped = 0;
+  uint32_t maxJitter = 0;
+  uint64_t totalJitter = 0;
+
+  void record(uint32_t jitter) {
+    ticks++;
+    totalJitter += jitter;
+    maxJitter = jitter > maxJitter ? jitter : maxJitter;
+  };
+  uint32_t getAverageJitter() {
+    return ticks ? totalJitter / ticks : 0;
+  };
 };
 
 class Clock : public Actor::Actor {
@@ -33,6 +89,34 @@ private:
   // Thread used to run clock, separate from actor thread
   rtos::Thread clockThread;
 
+  // only touched from the clock thread, times are microseconds since the
+  // clock started
+  int tickEvent = 0;
+  uint64_t time = 0;
+  uint32_t lastMicros = 0;
+  uint64_t nextTickAt = 0;
+  uint64_t lastTickAt = 0;
+  uint32_t frame = 0;
+
+  // while free running the clock actor publishes ticks from its handler
+  // instead of the clock thread, `stepping` is set while it does and is only
+  // cleared on the clock thread, once ticking has been handed back to it
+  volatile bool freeRunning = false;
+  volatile bool stepping = false;
+
+  volatile bool paused = false;
+  volatile uint16_t steps = 0;  // ticks left to publish while paused
+
+  uint64_t updateTime();
+  void scheduleTick();
+  void publishTick(uint64_t at, uint32_t elapsed, uint16_t skipped);
+  void dispatchStep();
+
+  friend void clockTickCallback(Clock *clock);
+  friend void clockSetTickDurationCallback(Clock *clock, int milliseconds);
+  friend void clockSetFreeRunningCallback(Clock *clock, bool freeRunning);
+  friend void clockResumeCallback(Clock *clock);
+
 public:
   const char *getName() {
     return "clock";
@@ -45,15 +129,45 @@ public:
   // Returns the milliseconds between each Clock tick
   int getTickDuration();
 
-  // Sets the milliseconds between each Clock tick
+  // Sets the milliseconds between each Clock tick, safe to call from any
+  // thread while the clock is running
   void setTickDuration(int milliseconds);
 
+  // Publish ticks back to back instead of waiting for the tick duration, for
+  // replaying input as fast as possible (see `Input::startReplay`). Ticks
+  // still report one tick duration as elapsed. With the cooperative scheduler
+  // every message a tick causes is handled before the next tick, with threads
+  // actors that fall behind have ticks coalesced (see `Tick`). Safe to call
+  // from any thread.
+  void setFreeRunning(bool freeRunning);
+  bool isFreeRunning() {
+    return freeRunning;
+  };
+
+  // A paused clock keeps its schedule but only publishes the ticks asked for
+  // with `step`, one per tick duration. Safe to call from any thread.
+  void setPaused(bool paused);
+  bool isPaused() {
+    return paused;
+  };
+  void step(uint16_t ticks = 1);
+
+  ClockStats stats;
+
   ::Actor::Message tickMessage;
 };
 
 // Tick callback that publishes the tick event to subscribers
 void clockTickCallback(Clock *clock);
 
+// Moves the pending tick to match a new tick duration, see `Clock::setTickDuration`
+void clockSetTickDurationCallback(Clock *clock, int milliseconds);
+
+// Hands ticking between the clock thread and the clock actor, see
+// `Clock::setFreeRunning`
+void clockSetFreeRunningCallback(Clock *clock, bool freeRunning);
+void clockResumeCallback(Clock *clock);
+
 }  // namespace Kywy
 
 #endif
@@ -0,0 +1,306 @@
+// SPDX-FileCopyrightText: 2025 KOINSLOT, Inc.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "Collider.hpp"
+#include "Events.hpp"
+
+#define COLLIDER_CELLS (COLLIDER_COLUMNS * COLLIDER_ROWS)
+
+void Collider::add(GraphicsObject *object, ColliderOptions options) {
+  add(object, nullptr, options.getLayers());
+}
+
+void Collider::add(Sprite *sprite, ColliderOptions options) {
+  add(sprite, options.getPixelPerfect() ? sprite : nullptr, options.getLayers());
+}
+
+void Collider::add(GraphicsObject *object, Sprite *sprite, uint16_t layers) {
+  for (uint8_t i = 0; i < numEntries; i++) {
+    if (entries[i].object == object) {
+      entries[i].sprite = sprite;  // already added, take the new options
+      entries[i].layers = layers;
+      return;
+    }
+  }
+
+  if (numEntries == COLLIDER_MAX_OBJECTS) {
+    return;  // TODO: error
+  }
+
+  Entry &entry = entries[numEntries++];
+  entry.object = object;
+  entry.sprite = sprite;
+  entry.layers = layers;
+}
+
+void Collider::remove(GraphicsObject *object) {
+  for (uint8_t i = 0; i < numEntries; i++) {
+    if (entries[i].object != object) {
+      continue;
+    }
+
+    // keep the order of the rest, collisions name the earlier object first
+    for (uint8_t j = i + 1; j < numEntries; j++) {
+      entries[j - 1] = entries[j];
+    }
+    numEntries--;
+    return;
+  }
+}
+
+bool Collider::collided(GraphicsObject *object, GraphicsObject *other) {
+  for (uint8_t i = 0; i < numCollisions; i++) {
+    if ((collisions[i].object == object && collisions[i].other == other) || (collisions[i].object == other && collisions[i].other == object)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+static inline uint8_t getColumn(int16_t x) {
+  return x < 0 ? 0 : (x / COLLIDER_CELL_SIZE >= COLLIDER_COLUMNS ? COLLIDER_COLUMNS - 1 : x / COLLIDER_CELL_SIZE);
+}
+
+static inline uint8_t getRow(int16_t y) {
+  return y < 0 ? 0 : (y / COLLIDER_CELL_SIZE >= COLLIDER_ROWS ? COLLIDER_ROWS - 1 : y / COLLIDER_CELL_SIZE);
+}
+
+// counting sort of the visible entries into the cells they cover, objects off
+// screen land in the edge cells
+void Collider::sortIntoCells() {
+  uint16_t counts[COLLIDER_CELLS] = {};
+  numActive = 0;
+  numLarge = 0;
+
+  for (uint8_t i = 0; i < numEntries; i++) {
+    Entry &entry = entries[i];
+    if (!entry.object->isVisible()) {
+      continue;
+    }
+
+    int16_t x, y;
+    uint16_t width, height;
+    entry.object->getBounds(x, y, width, height);
+    if (width == 0 || height == 0) {
+      continue;
+    }
+
+    int32_t right = (int32_t)x + width, bottom = (int32_t)y + height;
+    entry.bounds = Rect{ x, y, (int16_t)(right > INT16_MAX ? INT16_MAX : right), (int16_t)(bottom > INT16_MAX ? INT16_MAX : bottom) };
+    entry.cellLeft = getColumn(entry.bounds.left);
+    entry.cellTop = getRow(entry.bounds.top);
+    entry.cellRight = getColumn(entry.bounds.right - 1);
+    entry.cellBottom = getRow(entry.bounds.bottom - 1);
+
+    active[numActive++] = i;
+
+    if ((entry.cellRight - entry.cellLeft + 1) * (entry.cellBottom - entry.cellTop + 1) > 4) {
+      large[numLarge++] = i;
+      entry.cellLeft = 1;  // an empty range keeps it out of the cells
+      entry.cellRight = 0;
+      continue;
+    }
+
+    for (uint8_t row = entry.cellTop; row <= entry.cellBottom; row++) {
+      for (uint8_t column = entry.cellLeft; column <= entry.cellRight; column++) {
+        counts[row * COLLIDER_COLUMNS + column]++;
+      }
+    }
+  }
+
+  // each cell's run starts where the previous one ends, then runs are filled
+  // back to front so entries stay in the order they were added
+  uint16_t start = 0;
+  for (uint16_t cell = 0; cell < COLLIDER_CELLS; cell++) {
+    start += counts[cell];
+    cellStarts[cell] = start;
+  }
+  cellStarts[COLLIDER_CELLS] = start;
+
+  for (int16_t i = numActive - 1; i >= 0; i--) {
+    Entry &entry = entries[active[i]];
+    for (uint8_t row = entry.cellTop; row <= entry.cellBottom; row++) {
+      for (uint8_t column = entry.cellLeft; column <= entry.cellRight; column++) {
+        cellEntries[--cellStarts[row * COLLIDER_COLUMNS + column]] = active[i];
+      }
+    }
+  }
+}
+
+void Collider::check() {
+  numCollisions = 0;
+  stats.checks++;
+  uint32_t collisionsBefore = stats.collisions;
+
+  sortIntoCells();
+
+  for (uint16_t cell = 0; cell < COLLIDER_CELLS; cell++) {
+    uint16_t end = cellStarts[cell + 1];
+    for (uint16_t i = cellStarts[cell]; i < end; i++) {
+      Entry &entry = entries[cellEntries[i]];
+      for (uint16_t j = i + 1; j < end; j++) {
+        Entry &other = entries[cellEntries[j]];
+        if (!(entry.layers & other.layers)) {
+          continue;
+        }
+
+        // a pair can share several cells, it's only tested in the one holding
+        // the top left corner of where they'd overlap
+        int16_t left = entry.bounds.left > other.bounds.left ? entry.bounds.left : other.bounds.left;
+        int16_t top = entry.bounds.top > other.bounds.top ? entry.bounds.top : other.bounds.top;
+        if (getRow(top) * COLLIDER_COLUMNS + getColumn(left) != cell) {
+          continue;
+        }
+
+        test(entry, other);
+      }
+    }
+  }
+
+  for (uint8_t i = 0; i < numLarge; i++) {
+    for (uint8_t j = 0; j < numActive; j++) {
+      uint8_t index = large[i], otherIndex = active[j];
+      if (otherIndex == index) {
+        continue;
+      }
+
+      Entry &other = entries[otherIndex];
+      if (other.cellLeft > other.cellRight && otherIndex < index) {
+        continue;  // two large objects, tested when the other was first
+      }
+      if (!(entries[index].layers & other.layers)) {
+        continue;
+      }
+
+      if (index < otherIndex) {
+        test(entries[index], other);
+      } else {
+        test(other, entries[index]);
+      }
+    }
+  }
+
+  if (stats.collisions == collisionsBefore) {
+    return;
+  }
+
+  // one message for all of them, subscribers read the pairs from the collider
+  CollisionCheck collisionCheck = { stats.checks, (uint16_t)(stats.collisions - collisionsBefore) };
+  ::Actor::Message message(Kywy::Events::COLLISION);
+  message.setPayload(collisionCheck);
+  publish(message);
+}
+
+void Collider::test(Entry &entry, Entry &other) {
+  stats.pairTests++;
+
+  if (entry.bounds.left >= other.bounds.right || other.bounds.left >= entry.bounds.right || entry.bounds.top >= other.bounds.bottom || other.bounds.top >= entry.bounds.bottom) {
+    return;
+  }
+
+  if (entry.sprite || other.sprite) {
+    stats.pixelTests++;
+    if (!pixelsOverlap(entry, other)) {
+      return;
+    }
+  }
+
+  stats.collisions++;
+
+  if (numCollisions < COLLIDER_MAX_COLLISIONS) {
+    collisions[numCollisions++] = { entry.object, other.object };
+  } else {
+    stats.dropped++;
+  }
+}
+
+// where a sprite's current frame starts and how to read it, pixels are drawn
+// where a bit is clear, or set for negative sprites
+struct FrameMask {
+  const uint8_t *bitmap;
+  uint32_t bitIndex;
+  uint16_t stride;
+  uint32_t invert;
+};
+
+static bool getFrameMask(Sprite *sprite, FrameMask &mask) {
+  if (!sprite || sprite->frame >= sprite->numFrames) {
+    return false;  // solid
+  }
+
+  if (sprite->frameViews) {
+    const Display::BitmapView &view = sprite->frameViews[sprite->frame];
+    mask.bitmap = view.bitmap;
+    mask.bitIndex = (uint32_t)view.stride * view.y + view.x;
+    mask.stride = view.stride;
+  } else {
+    mask.bitmap = sprite->frames[sprite->frame];
+    mask.bitIndex = 0;
+    mask.stride = sprite->width;
+  }
+  mask.invert = sprite->negative ? 0 : 0xffffffff;
+
+  return mask.bitmap != nullptr;
+}
+
+// `count` (1 to 32) bitmap bits starting at `bitIndex`, MSB aligned, without
+// reading past the last byte they're in
+static inline uint32_t readBits(const uint8_t *bitmap, uint32_t bitIndex, uint8_t count) {
+  const uint8_t *source = bitmap + bitIndex / 8;
+  uint8_t shift = bitIndex % 8;
+  uint8_t bytes = (shift + count + 7) / 8;
+
+  uint64_t bits = 0;
+  for (uint8_t i = 0; i < bytes; i++) {
+    bits |= (uint64_t)source[i] << (56 - 8 * i);
+  }
+  return (uint32_t)((bits << shift) >> 32);
+}
+
+// ANDs the rows of the two frames where their bounds overlap, 32 pixels at a
+// time, an object that isn't pixel-perfect counts as solid
+bool Collider::pixelsOverlap(Entry &entry, Entry &other) {
+  FrameMask mask = {}, otherMask = {};
+  bool masked = getFrameMask(entry.sprite, mask);
+  bool otherMasked = getFrameMask(other.sprite, otherMask);
+
+  int16_t left = entry.bounds.left > other.bounds.left ? entry.bounds.left : other.bounds.left;
+  int16_t top = entry.bounds.top > other.bounds.top ? entry.bounds.top : other.bounds.top;
+  int16_t right = entry.bounds.right < other.bounds.right ? entry.bounds.right : other.bounds.right;
+  int16_t bottom = entry.bounds.bottom < other.bounds.bottom ? entry.bounds.bottom : other.bounds.bottom;
+
+  if (!masked && !otherMasked) {
+    return true;
+  }
+
+  // first overlapping bit of each frame
+  uint32_t row = masked ? mask.bitIndex + (uint32_t)mask.stride * (top - entry.bounds.top) + (left - entry.bounds.left) : 0;
+  uint32_t otherRow = otherMasked ? otherMask.bitIndex + (uint32_t)otherMask.stride * (top - other.bounds.top) + (left - other.bounds.left) : 0;
+
+  for (int16_t y = top; y < bottom; y++) {
+    for (int16_t x = left; x < right; x += 32) {
+      uint8_t count = right - x > 32 ? 32 : right - x;
+      uint32_t used = 0xffffffff << (32 - count);
+
+      uint32_t bits = masked ? readBits(mask.bitmap, row + (x - left), count) ^ mask.invert : 0xffffffff;
+      uint32_t otherBits = otherMasked ? readBits(otherMask.bitmap, otherRow + (x - left), count) ^ otherMask.invert : 0xffffffff;
+      if (bits & otherBits & used) {
+        return true;
+      }
+    }
+
+    row += mask.stride;
+    otherRow += otherMask.stride;
+  }
+
+  return false;
+}
+
+void Collider::handle(::Actor::Message *message) {
+  switch (message->signal) {
+    case Kywy::Events::TICK:
+      check();
+      break;
+  }
+}
@@ -0,0 +1,147 @@
+// SPDX-FileCopyrightText: 2025 KOINSLOT, Inc.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef KYWY_LIB_COLLIDER
+#define KYWY_LIB_COLLIDER 1
+
+#include "Actor.hpp"
+#include "Display.hpp"
+#include "GraphicsObject.hpp"
+#include "Sprite.hpp"
+
+#include <stdint.h>
+
+#define COLLIDER_MAX_OBJECTS 128
+#define COLLIDER_MAX_COLLISIONS 32  // kept per check, more are only counted
+
+// side of a spatial hash cell in pixels, the screen is 9 x 11 cells
+#define COLLIDER_CELL_SIZE 16
+#define COLLIDER_COLUMNS ((KYWY_DISPLAY_WIDTH + COLLIDER_CELL_SIZE - 1) / COLLIDER_CELL_SIZE)
+#define COLLIDER_ROWS ((KYWY_DISPLAY_HEIGHT + COLLIDER_CELL_SIZE - 1) / COLLIDER_CELL_SIZE)
+
+struct ColliderOptions {
+  uint16_t _layers = 0xffff;
+  bool _pixelPerfect = false;
+
+  // objects only collide if their layers share a bit
+  ColliderOptions layers(uint16_t setLayers) {
+    _layers = setLayers;
+    return *this;
+  };
+  uint16_t getLayers() {
+    return _layers;
+  };
+
+  // sprites only, collide when their drawn pixels overlap instead of their
+  // bounds
+  ColliderOptions pixelPerfect(bool setPixelPerfect) {
+    _pixelPerfect = setPixelPerfect;
+    return *this;
+  };
+  bool getPixelPerfect() {
+    return _pixelPerfect;
+  };
+};
+
+// an overlapping pair, `object` was added before `other`
+struct Collision {
+  GraphicsObject *object;
+  GraphicsObject *other;
+};
+
+// payload of COLLISION, read the pairs with `Collider::getCollisions`
+struct CollisionCheck {
+  uint32_t check;  // `ColliderStats::checks` as of this check, a later check replaces the pairs
+  uint16_t found;  // overlapping pairs, only the first COLLIDER_MAX_COLLISIONS are kept
+};
+
+struct ColliderStats {
+  uint32_t checks = 0;
+  uint32_t pairTests = 0;   // bounding box tests, the pairs the spatial hash didn't rule out
+  uint32_t pixelTests = 0;  // pairs whose bounds overlapped and had a pixel-perfect object
+  uint32_t collisions = 0;
+  uint32_t dropped = 0;  // collisions past COLLIDER_MAX_COLLISIONS in a check, not kept
+};
+
+// Finds which of its objects overlap, using their `GraphicsObject::getBounds`.
+// Objects are sorted into a grid of COLLIDER_CELL_SIZE cells first so only
+// objects sharing a cell are tested against each other. Objects spanning more
+// than 2 x 2 cells are tested against everything instead.
+//
+// `check` publishes one COLLISION when it finds any overlapping pairs, and
+// subscribers read them with `getCollisions`, e.g.
+//   collider.add(&ship, ColliderOptions().pixelPerfect(true));
+//   collider.subscribe(&engine.clock, ::Actor::signalMask(Kywy::Events::TICK));
+//   collider.start();
+//   game.subscribe(&collider);
+// checks every tick. Without starting it, call `check` once things have moved.
+// Hidden objects don't collide. The pairs are only stable while the collider
+// can't check again, so subscribers should share its handler lock (the
+// default). A message per pair could take the whole message pool in a busy
+// frame.
+class Collider : public Actor::Actor {
+public:
+  // adds an object that collides with its bounds
+  void add(GraphicsObject *object, ColliderOptions options = ColliderOptions());
+  void add(Sprite *sprite, ColliderOptions options = ColliderOptions());
+  void remove(GraphicsObject *object);
+
+  // finds this frame's collisions and publishes a COLLISION if there are any
+  void check();
+
+  // the collisions found by the last `check`
+  const Collision *getCollisions() {
+    return collisions;
+  };
+  uint8_t getNumCollisions() {
+    return numCollisions;
+  };
+
+  // true if the two overlapped in the last `check`
+  bool collided(GraphicsObject *object, GraphicsObject *other);
+
+  void handle(::Actor::Message *message);
+
+  const char *getName() {
+    return "collider";
+  };
+
+  ColliderStats stats;
+
+private:
+  // right and bottom are exclusive
+  struct Rect {
+    int16_t left, top, right, bottom;
+  };
+
+  struct Entry {
+    GraphicsObject *object;
+    Sprite *sprite;  // nullptr unless pixel-perfect
+    uint16_t layers;
+    Rect bounds;
+    uint8_t cellLeft, cellTop, cellRight, cellBottom;  // inclusive
+  };
+
+  Entry entries[COLLIDER_MAX_OBJECTS];
+  uint8_t numEntries = 0;
+
+  // entries sorted by cell, each cell's run starts at `cellStarts[cell]`
+  uint16_t cellStarts[COLLIDER_COLUMNS * COLLIDER_ROWS + 1];
+  uint8_t cellEntries[COLLIDER_MAX_OBJECTS * 4];
+
+  uint8_t active[COLLIDER_MAX_OBJECTS];  // visible entries
+  uint8_t numActive = 0;
+  uint8_t large[COLLIDER_MAX_OBJECTS];  // entries spanning more than 2 x 2 cells
+  uint8_t numLarge = 0;
+
+  Collision collisions[COLLIDER_MAX_COLLISIONS];
+  uint8_t numCollisions = 0;
+
+  void add(GraphicsObject *object, Sprite *sprite, uint16_t layers);
+  void sortIntoCells();
+  void test(Entry &entry, Entry &other);
+  bool pixelsOverlap(Entry &entry, Entry &other);
+};
+
+#endif
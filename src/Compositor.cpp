@@ -0,0 +1,188 @@
+// SPDX-FileCopyrightText: 2025 KOINSLOT, Inc.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "Compositor.hpp"
+
+static const uint8_t NO_RECT = 0xff;
+
+void Compositor::add(GraphicsObject *object) {
+  if (numEntries == COMPOSITOR_MAX_OBJECTS) {
+    return;  // TODO: error
+  }
+
+  for (uint8_t i = 0; i < numEntries; i++) {
+    if (entries[i].object == object) {
+      return;  // already added
+    }
+  }
+
+  entries[numEntries++] = Entry{ object, Rect{ 0, 0, 0, 0 }, false };
+  object->dirty = true;
+}
+
+void Compositor::remove(GraphicsObject *object) {
+  for (uint8_t i = 0; i < numEntries; i++) {
+    if (entries[i].object != object) {
+      continue;
+    }
+
+    if (entries[i].visible) {
+      addDirtyRect(entries[i].bounds);  // uncover whatever was underneath
+    }
+
+    // keep the z-order of the rest
+    for (uint8_t j = i + 1; j < numEntries; j++) {
+      entries[j - 1] = entries[j];
+    }
+    numEntries--;
+    return;
+  }
+}
+
+void Compositor::setBackground(uint16_t color) {
+  background = color ? 0xff : 0x00;
+  invalidated = true;
+}
+
+void Compositor::invalidate() {
+  invalidated = true;
+}
+
+static inline bool overlaps(int16_t left, int16_t top, int16_t right, int16_t bottom,
+                            int16_t otherLeft, int16_t otherTop, int16_t otherRight, int16_t otherBottom) {
+  return left < otherRight && otherLeft < right && top < otherBottom && otherTop < bottom;
+}
+
+// the smallest rectangle covering both
+Compositor::Rect Compositor::unite(Rect rect, Rect other) {
+  return Rect{
+    rect.left < other.left ? rect.left : other.left,
+    rect.top < other.top ? rect.top : other.top,
+    rect.right > other.right ? rect.right : other.right,
+    rect.bottom > other.bottom ? rect.bottom : other.bottom,
+  };
+}
+
+Compositor::Rect Compositor::getBounds(GraphicsObject *object) {
+  int16_t x, y;
+  uint16_t width, height;
+  object->getBounds(x, y, width, height);
+
+  int32_t right = (int32_t)x + width, bottom = (int32_t)y + height;
+  return Rect{ x, y, (int16_t)(right > INT16_MAX ? INT16_MAX : right), (int16_t)(bottom > INT16_MAX ? INT16_MAX : bottom) };
+}
+
+void Compositor::addDirtyRect(Rect rect) {
+  // only the screen can be repainted
+  if (rect.left < 0)
+    rect.left = 0;
+  if (rect.top < 0)
+    rect.top = 0;
+  if (rect.right > display->driver->getWidth())
+    rect.right = display->driver->getWidth();
+  if (rect.bottom > display->driver->getHeight())
+    rect.bottom = display->driver->getHeight();
+
+  if (rect.left >= rect.right || rect.top >= rect.bottom)
+    return;
+
+  while (true) {
+    // rectangles that touch are repainted as one so nothing is drawn twice
+    uint8_t merge = NO_RECT;
+    for (uint8_t i = 0; i < numDirtyRects; i++) {
+      Rect &other = dirtyRects[i];
+      if (overlaps(rect.left, rect.top, rect.right + 1, rect.bottom + 1,
+                   other.left, other.top, other.right + 1, other.bottom + 1)) {
+        merge = i;
+        break;
+      }
+    }
+
+    if (merge == NO_RECT && numDirtyRects == COMPOSITOR_MAX_DIRTY_RECTS) {
+      // out of room, merge with whichever rectangle grows the least
+      uint32_t leastGrowth = UINT32_MAX;
+      for (uint8_t i = 0; i < numDirtyRects; i++) {
+        Rect &other = dirtyRects[i];
+        Rect united = unite(rect, other);
+        uint32_t growth = (uint32_t)(united.right - united.left) * (united.bottom - united.top) - (uint32_t)(other.right - other.left) * (other.bottom - other.top);
+        if (growth < leastGrowth) {
+          leastGrowth = growth;
+          merge = i;
+        }
+      }
+    }
+
+    if (merge == NO_RECT)
+      break;
+
+    rect = unite(rect, dirtyRects[merge]);
+    dirtyRects[merge] = dirtyRects[--numDirtyRects];
+  }
+
+  dirtyRects[numDirtyRects++] = rect;
+}
+
+void Compositor::repaint(Rect rect) {
+  Display::Driver::Driver *driver = display->driver;
+  uint16_t width = rect.right - rect.left, height = rect.bottom - rect.top;
+
+  driver->setClip(rect.left, rect.top, width, height);
+  driver->setBufferBlock(rect.left, rect.top, width, height, background);
+
+  stats.rects++;
+  stats.pixels += (uint32_t)width * height;
+
+  for (uint8_t i = 0; i < numEntries; i++) {
+    Entry &entry = entries[i];
+    if (entry.visible && overlaps(rect.left, rect.top, rect.right, rect.bottom,
+                                  entry.bounds.left, entry.bounds.top, entry.bounds.right, entry.bounds.bottom)) {
+      entry.object->draw();
+      stats.draws++;
+    }
+  }
+}
+
+void Compositor::render() {
+  if (!display) {
+    return;  // TODO: error
+  }
+
+  if (invalidated) {
+    addDirtyRect(Rect{ 0, 0, (int16_t)display->driver->getWidth(), (int16_t)display->driver->getHeight() });
+    invalidated = false;
+  }
+
+  // an object dirties where it was and where it is now
+  for (uint8_t i = 0; i < numEntries; i++) {
+    Entry &entry = entries[i];
+    GraphicsObject *object = entry.object;
+
+    bool visible = object->isVisible();
+    Rect bounds = visible ? getBounds(object) : entry.bounds;
+
+    bool moved = bounds.left != entry.bounds.left || bounds.top != entry.bounds.top || bounds.right != entry.bounds.right || bounds.bottom != entry.bounds.bottom;
+    if (!object->dirty && visible == entry.visible && !moved) {
+      continue;
+    }
+
+    if (entry.visible)
+      addDirtyRect(entry.bounds);
+    if (visible)
+      addDirtyRect(bounds);
+
+    entry.bounds = bounds;
+    entry.visible = visible;
+    object->dirty = false;
+  }
+
+  display->lock();
+  for (uint8_t i = 0; i < numDirtyRects; i++) {
+    repaint(dirtyRects[i]);
+  }
+  display->driver->clearClip();
+  display->unlock();
+
+  numDirtyRects = 0;
+  stats.frames++;
+}
@@ -0,0 +1,82 @@
+// SPDX-FileCopyrightText: 2025 KOINSLOT, Inc.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef KYWY_LIB_COMPOSITOR
+#define KYWY_LIB_COMPOSITOR 1
+
+#include "Display.hpp"
+#include "GraphicsObject.hpp"
+
+#include <stdint.h>
+
+#define COMPOSITOR_MAX_OBJECTS 32
+#define COMPOSITOR_MAX_DIRTY_RECTS 8
+
+struct CompositorStats {
+  uint32_t frames = 0;
+  uint32_t rects = 0;   // dirty rectangles repainted
+  uint32_t pixels = 0;  // area of the dirty rectangles
+  uint32_t draws = 0;   // objects drawn into them
+};
+
+// Keeps a list of objects in z-order and repaints only what changed: the
+// rectangles an object moved out of and into are cleared to the background
+// and every object overlapping them is drawn again, bottom to top, clipped to
+// the rectangle. Nothing else in the buffer is touched, so only the changed
+// lines go out in the next `Display::update`.
+//
+// Objects added here shouldn't also be drawn with `GraphicsObject::render`,
+// and anything else drawn to the display is kept until an object passes over
+// it.
+class Compositor {
+public:
+  Compositor() {}
+  Compositor(Display::Display *display)
+    : display(display) {}
+
+  // adds an object on top of the ones already added
+  void add(GraphicsObject *object);
+  void remove(GraphicsObject *object);
+
+  // color empty areas are repainted with, white by default
+  void setBackground(uint16_t color);
+
+  // repaint the whole screen on the next `render`
+  void invalidate();
+
+  // repaints the dirty rectangles, follow with `Display::update` to send them
+  void render();
+
+  Display::Display *display = nullptr;
+
+  CompositorStats stats;
+
+private:
+  // right and bottom are exclusive
+  struct Rect {
+    int16_t left, top, right, bottom;
+  };
+
+  struct Entry {
+    GraphicsObject *object;
+    Rect bounds;  // where it was last drawn
+    bool visible;
+  };
+
+  Entry entries[COMPOSITOR_MAX_OBJECTS];
+  uint8_t numEntries = 0;
+
+  Rect dirtyRects[COMPOSITOR_MAX_DIRTY_RECTS];
+  uint8_t numDirtyRects = 0;
+
+  uint16_t background = 0xff;
+  bool invalidated = true;
+
+  static Rect unite(Rect rect, Rect other);
+  Rect getBounds(GraphicsObject *object);
+  void addDirtyRect(Rect rect);
+  void repaint(Rect rect);
+};
+
+#endif
@@ -0,0 +1,200 @@
+// SPDX-FileCopyrightText: 2025 KOINSLOT, Inc.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "Console.hpp"
+#include "Kywy.hpp"
+#include "Profiler.hpp"
+
+#include <new>
+#include <stdlib.h>
+#include <string.h>
+
+namespace Kywy {
+
+void consolePollCallback(Console *console) {
+  // coalesces, so a busy console is only ever asked once
+  ::Actor::Message poll(Events::CONSOLE_POLL, nullptr, ::Actor::PRIORITY_LOW);
+  poll.coalesce = true;
+  console->dispatch(poll);
+}
+
+void Console::initialize() {
+  poller.attach(mbed::callback(&consolePollCallback, this), CONSOLE_POLL_INTERVAL);
+}
+
+void Console::handle(::Actor::Message *message) {
+  switch (message->signal) {
+    case Events::CONSOLE_POLL:
+      {
+        poll();
+        break;
+      }
+    default:
+      {
+        break;
+      }
+  }
+}
+
+// only reads what has already arrived, so it never waits on Serial
+void Console::poll() {
+  while (Serial.available() > 0) {
+    int c = Serial.read();
+    if (c < 0) {
+      break;
+    }
+
+    if (c == '\r') {
+      continue;
+    }
+
+    if (c != '\n') {
+      if (lineLength < CONSOLE_LINE_SIZE - 1) {
+        line[lineLength++] = c;
+      } else {
+        lineOverflow = true;
+      }
+      continue;
+    }
+
+    line[lineLength] = '\0';
+    if (lineOverflow) {
+      Serial.println("command too long");
+    } else {
+      execute(line);
+    }
+    lineLength = 0;
+    lineOverflow = false;
+  }
+}
+
+void Console::execute(char *command) {
+  char *name = strtok(command, " ");
+  char *argument = strtok(nullptr, " ");
+
+  if (name == nullptr) {
+    return;  // empty line
+  }
+
+  if (!strcmp(name, "tick")) {
+    int ticks = argument ? atoi(argument) : 1;
+    if (ticks < 1 || ticks > UINT16_MAX) {
+      Serial.println("usage: tick [n]");
+      return;
+    }
+    engine->clock.setPaused(true);
+    engine->clock.step(ticks);
+  } else if (!strcmp(name, "run")) {
+    engine->clock.setPaused(false);
+  } else if (!strcmp(name, "pause")) {
+    engine->clock.setPaused(true);
+  } else if (!strcmp(name, "fps")) {
+    int fps = argument ? atoi(argument) : 0;
+    if (fps < 1 || fps > 1000) {
+      Serial.println("usage: fps <1-1000>");
+      return;
+    }
+    engine->clock.setTickDuration(1000 / fps);
+  } else if (!strcmp(name, "dump") && argument && !strcmp(argument, "stats")) {
+    printStats();
+  } else if (!strcmp(name, "dump") && argument && !strcmp(argument, "profile")) {
+    Profiler::dump(Serial);
+  } else if (!strcmp(name, "screenshot")) {
+    printScreenshot();
+  } else {
+    Serial.println("unknown command");
+  }
+}
+
+void Console::printStats() {
+  char text[160];
+
+  snprintf(text, sizeof(text), "dispatch: handled %lu, filtered %lu, coalesced %lu, latency avg %luus max %luus",
+           (unsigned long)::Actor::dispatchStats.messagesHandled,
+           (unsigned long)::Actor::dispatchStats.messagesFiltered,
+           (unsigned long)::Actor::dispatchStats.messagesCoalesced,
+           (unsigned long)::Actor::dispatchStats.getAverageLatency(),
+           (unsigned long)::Actor::dispatchStats.maxLatency);
+  Serial.println(text);
+
+  snprintf(text, sizeof(text), "pool: in use %u, high water %u, exhausted %lu",
+           (unsigned)::Actor::messagePool.getInUse(),
+           (unsigned)::Actor::messagePool.getHighWater(),
+           (unsigned long)::Actor::messagePool.getExhausted());
+  Serial.println(text);
+
+  if (::Actor::getSchedulerMode() == ::Actor::SCHEDULER_COOPERATIVE) {
+    snprintf(text, sizeof(text), "scheduler: queued %u, high water %u, dropped %lu",
+             (unsigned)::Actor::scheduler.getQueued(),
+             (unsigned)::Actor::scheduler.getHighWater(),
+             (unsigned long)::Actor::scheduler.getDropped());
+    Serial.println(text);
+  }
+
+  ClockStats &clock = engine->clock.stats;
+  snprintf(text, sizeof(text), "clock: %dms, ticks %lu, overruns %lu, skipped %lu, jitter avg %luus max %luus%s",
+           engine->clock.getTickDuration(),
+           (unsigned long)clock.ticks, (unsigned long)clock.overruns,
+           (unsigned long)clock.skipped, (unsigned long)clock.getAverageJitter(),
+           (unsigned long)clock.maxJitter,
+           engine->clock.isPaused() ? ", paused" : "");
+  Serial.println(text);
+
+  InputStats &input = engine->input.stats;
+  snprintf(text, sizeof(text), "input: edges %lu, bounces %lu, dropped %lu, latency avg %luus max %luus, unseen avg %luus max %luus",
+           (unsigned long)input.edges, (unsigned long)input.bounces,
+           (unsigned long)input.dropped, (unsigned long)input.getAverageLatency(),
+           (unsigned long)input.maxLatency, (unsigned long)input.getAverageUnseen(),
+           (unsigned long)input.maxUnseen);
+  Serial.println(text);
+
+  snprintf(text, sizeof(text), "display: updates %lu",
+           (unsigned long)engine->display.getUpdates());
+  Serial.println(text);
+}
+
+// plain PBM, copy from "P1" on into a .pbm file to view it
+void Console::printScreenshot() {
+  Display::Driver::Driver *driver = engine->display.driver;
+  uint16_t width = driver->getWidth(), height = driver->getHeight();
+  char row[KYWY_DISPLAY_HEIGHT + 1];  // the longest side
+
+  // Serial can block for as long as the host isn't reading, so copy the frame
+  // under the lock and print it afterwards, a bit per pixel
+  uint8_t *pixels = new (std::nothrow) uint8_t[(width * height + 7) / 8];
+  if (!pixels) {
+    Serial.println("screenshot: out of memory");
+    return;
+  }
+  memset(pixels, 0, (width * height + 7) / 8);
+
+  // hold the buffer so the image isn't half of one frame and half of the next
+  driver->lock();
+  for (uint16_t y = 0; y < height; y++) {
+    for (uint16_t x = 0; x < width; x++) {
+      uint32_t i = (uint32_t)y * width + x;
+      if (driver->getBufferPixel(x, y)) {
+        pixels[i / 8] |= 1 << (i % 8);
+      }
+    }
+  }
+  driver->unlock();
+
+  Serial.println("P1");
+  snprintf(row, sizeof(row), "%u %u", width, height);
+  Serial.println(row);
+
+  for (uint16_t y = 0; y < height; y++) {
+    for (uint16_t x = 0; x < width; x++) {
+      uint32_t i = (uint32_t)y * width + x;
+      row[x] = pixels[i / 8] & (1 << (i % 8)) ? '0' : '1';  // 1 is black
+    }
+    row[width] = '\0';
+    Serial.println(row);
+  }
+
+  delete[] pixels;
+}
+
+}  // namespace Kywy
@@ -0,0 +1,62 @@
+// SPDX-FileCopyrightText: 2025 KOINSLOT, Inc.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef KYWY_LIB_CONSOLE
+#define KYWY_LIB_CONSOLE 1
+
+#include "Actor.hpp"
+
+namespace Kywy {
+
+#define CONSOLE_LINE_SIZE 32
+#define CONSOLE_POLL_INTERVAL std::chrono::milliseconds(50)
+
+class Engine;
+
+// Reads debug commands from Serial a line at a time without blocking:
+//   tick [n]       pause the clock and send n ticks (default 1)
+//   run            resume the clock
+//   pause          pause the clock
+//   fps <n>        set the tick rate
+//   dump stats     print dispatch, clock, input and message pool stats
+//   dump profile   write the profiler's records (see `Profiler::dump`)
+//   screenshot     print the frame buffer as a plain text PBM image
+// Started by the engine when `EngineOptions::console` or `clickToTick` is set.
+// Replies are printed without any lock held, but printing waits on Serial, so
+// on the cooperative scheduler every actor waits while the host is slow to
+// read.
+class Console : public Actor::Actor {
+private:
+  Engine *engine = nullptr;
+
+  char line[CONSOLE_LINE_SIZE];
+  uint8_t lineLength = 0;
+  bool lineOverflow = false;
+
+  // wakes the actor from an interrupt, since it has to keep reading while the
+  // clock is paused
+  mbed::Ticker poller;
+
+  void poll();
+  void execute(char *command);
+  void printStats();
+  void printScreenshot();
+
+public:
+  Console(Engine *engine)
+    : engine(engine) {}
+
+  const char *getName() {
+    return "console";
+  };
+  void initialize();
+  void handle(::Actor::Message *message);
+};
+
+// Ticker callback that asks the console to check for serial input
+void consolePollCallback(Console *console);
+
+}  // namespace Kywy
+
+#endif
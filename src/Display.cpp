@@ -3,6 +3,8 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 
 #include "Display.hpp"
+#include "FixedPoint.hpp"
+#include "Profiler.hpp"
 
 namespace Display {
 
@@ -20,61 +22,333 @@ void MBED_SPI_DRIVER::initializeDisplay() {
 
   digitalWrite(KYWY_DISPLAY_CS, LOW);
 
+  if (doubleBuffering) {
+    doubleBuffering = false;  // force setup now that the SPI object exists
+    setDoubleBuffering(true);
+  }
+
   clearBuffer();
   sendBufferToDisplay();
 
   digitalWrite(KYWY_DISPLAY_DISP, HIGH);
-
-  setRotation(Rotation::DEFAULT);
 }
 
+// Drawing always happens in the rotated (logical) coordinate space: for 90 and
+// 270 degree rotations the buffer is laid out as 144 rows of 21 bytes instead
+// of 168 rows of 18 bytes, so draw calls pay nothing extra. The rotation is
+// applied once per flushed line in `getPhysicalLines`.
 void MBED_SPI_DRIVER::setRotation(Rotation rotation) {
+  this->rotation = rotation;
+
   switch (rotation) {
     case Rotation::DEFAULT:
+    case Rotation::CLOCKWISE_180:
+      rotatedWidth = 144;
+      rotatedHeight = 168;
       break;
     case Rotation::CLOCKWISE_90:
+    case Rotation::CLOCKWISE_270:
+      rotatedWidth = 168;
+      rotatedHeight = 144;
       break;
+  }
+  stride = rotatedWidth / 8;
+
+  // the old contents don't make sense in the new layout
+  memset(MBED_SPI_DRIVER_BUFFER, 0xff, sizeof(MBED_SPI_DRIVER_BUFFER));
+  memset(MBED_SPI_DRIVER_DIRTY_LINES, 0xff, sizeof(MBED_SPI_DRIVER_DIRTY_LINES));
+  memset(MBED_SPI_DRIVER_DRAWN_LINES, 0x00, sizeof(MBED_SPI_DRIVER_DRAWN_LINES));
+}
+
+void MBED_SPI_DRIVER::markBlockDirty(int16_t x, int16_t y, uint16_t width,
+                                    uint16_t height) {
+  // map the logical block onto the range of physical lines it covers
+  int16_t firstLine = y, lastLine = y + height - 1;
+  switch (rotation) {
+    case Rotation::DEFAULT:
+      break;
+    case Rotation::CLOCKWISE_90:
+      firstLine = x;
+      lastLine = x + width - 1;
+      break;
+    case Rotation::CLOCKWISE_180:
+      firstLine = 167 - (y + height - 1);
+      lastLine = 167 - y;
+      break;
+    case Rotation::CLOCKWISE_270:
+      firstLine = 167 - (x + width - 1);
+      lastLine = 167 - x;
+      break;
+  }
+
+  for (int16_t line = firstLine; line <= lastLine; line++) {
+    MBED_SPI_DRIVER_DIRTY_LINES[line / 8] |= 1 << (line % 8);
+    MBED_SPI_DRIVER_DRAWN_LINES[line / 8] |= 1 << (line % 8);
+  }
+}
+
+// Transposes an 8x8 block of pixels (MSB is the leftmost pixel), `rows` are
+// read `rowStride` bytes apart. From Hacker's Delight, 7-3.
+static void transpose8(const uint8_t *rows, int16_t rowStride, uint8_t *out) {
+  uint32_t x = ((uint32_t)rows[0] << 24) | ((uint32_t)rows[rowStride] << 16) | ((uint32_t)rows[2 * rowStride] << 8) | rows[3 * rowStride];
+  uint32_t y = ((uint32_t)rows[4 * rowStride] << 24) | ((uint32_t)rows[5 * rowStride] << 16) | ((uint32_t)rows[6 * rowStride] << 8) | rows[7 * rowStride];
+  uint32_t t;
+
+  t = (x ^ (x >> 7)) & 0x00AA00AA;
+  x = x ^ t ^ (t << 7);
+  t = (y ^ (y >> 7)) & 0x00AA00AA;
+  y = y ^ t ^ (t << 7);
+
+  t = (x ^ (x >> 14)) & 0x0000CCCC;
+  x = x ^ t ^ (t << 14);
+  t = (y ^ (y >> 14)) & 0x0000CCCC;
+  y = y ^ t ^ (t << 14);
+
+  t = (x & 0xF0F0F0F0) | ((y >> 4) & 0x0F0F0F0F);
+  y = ((x << 4) & 0xF0F0F0F0) | (y & 0x0F0F0F0F);
+  x = t;
+
+  out[0] = x >> 24;
+  out[1] = x >> 16;
+  out[2] = x >> 8;
+  out[3] = x;
+  out[4] = y >> 24;
+  out[5] = y >> 16;
+  out[6] = y >> 8;
+  out[7] = y;
+}
+
+const uint8_t *MBED_SPI_DRIVER::getPhysicalLines(uint8_t band) {
+  uint8_t *lines = MBED_SPI_DRIVER_BAND_BUFFER;
+  uint8_t block[8];
+
+  switch (rotation) {
+    case Rotation::DEFAULT:
+      return MBED_SPI_DRIVER_BUFFER + 8 * 18 * band;  // already in display order
+
     case Rotation::CLOCKWISE_180:
+      // physical (x, y) is logical (143 - x, 167 - y): lines come from the
+      // bottom up and each line is mirrored
+      for (uint8_t line = 0; line < 8; line++) {
+        const uint8_t *row = MBED_SPI_DRIVER_BUFFER + 18 * (167 - (8 * band + line));
+        for (uint8_t i = 0; i < 18; i++) {
+          lines[18 * line + i] = reverse(row[17 - i]);
+        }
+      }
+      break;
+
+    case Rotation::CLOCKWISE_90:
+      // physical (x, y) is logical (y, 143 - x): each 8x8 block of the band is
+      // a transposed block from logical byte column `band`, read bottom up
+      for (uint8_t i = 0; i < 18; i++) {
+        transpose8(MBED_SPI_DRIVER_BUFFER + 21 * (143 - 8 * i) + band, -21, block);
+        for (uint8_t line = 0; line < 8; line++) {
+          lines[18 * line + i] = block[line];
+        }
+      }
       break;
+
     case Rotation::CLOCKWISE_270:
+      // physical (x, y) is logical (167 - y, x): each 8x8 block of the band is
+      // a transposed block from logical byte column `20 - band`, read top down,
+      // with its lines in reverse order
+      for (uint8_t i = 0; i < 18; i++) {
+        transpose8(MBED_SPI_DRIVER_BUFFER + 21 * (8 * i) + (20 - band), 21, block);
+        for (uint8_t line = 0; line < 8; line++) {
+          lines[18 * line + i] = block[7 - line];
+        }
+      }
       break;
   }
+
+  return lines;
 }
 
 void MBED_SPI_DRIVER::clearBuffer() {
   memset(MBED_SPI_DRIVER_BUFFER, 0xff, sizeof(MBED_SPI_DRIVER_BUFFER));
+
+  // only lines that were drawn on since the last clear actually change
+  for (uint8_t i = 0; i < sizeof(MBED_SPI_DRIVER_DIRTY_LINES); i++) {
+    MBED_SPI_DRIVER_DIRTY_LINES[i] |= MBED_SPI_DRIVER_DRAWN_LINES[i];
+    MBED_SPI_DRIVER_DRAWN_LINES[i] = 0x00;
+  }
+}
+
+MBED_SPI_TRANSPORT::MBED_SPI_TRANSPORT(mbed::SPI *mbedSPI)
+  : mbedSPI(mbedSPI) {
+#if DEVICE_SPI_ASYNCH
+  mbedSPI->set_dma_usage(DMA_USAGE_OPPORTUNISTIC);
+#endif
+}
+
+void MBED_SPI_TRANSPORT::writeAsync(const uint8_t *data, uint16_t length,
+                                    Flusher *flusher) {
+  pending = flusher;
+  digitalWrite(KYWY_DISPLAY_CS, HIGH);
+
+#if DEVICE_SPI_ASYNCH
+  mbedSPI->transfer((const char *)data, length, (char *)nullptr, 0,
+                    mbed::callback(this, &MBED_SPI_TRANSPORT::onTransferComplete),
+                    SPI_EVENT_COMPLETE);
+#else
+  // no asynchronous SPI on this target, the frame is still packed in one go so
+  // this is a single blocking write
+  mbedSPI->write((const char *)data, length, nullptr, 0);
+  onTransferComplete(0);
+#endif
+}
+
+void MBED_SPI_TRANSPORT::onTransferComplete(int event) {
+  // may run in interrupt context
+  digitalWrite(KYWY_DISPLAY_CS, LOW);
+  pending->complete();
+}
+
+void MBED_SPI_TRANSPORT::idle() {
+  rtos::ThisThread::yield();
+}
+
+void MBED_SPI_DRIVER::setDoubleBuffering(bool enabled) {
+  if (enabled == doubleBuffering)
+    return;
+
+  doubleBuffering = enabled;
+
+  if (!enabled) {
+    delete flusher;  // waits for any in-flight flush
+    delete transport;
+    flusher = nullptr;
+    transport = nullptr;
+    return;
+  }
+
+  if (!mbedSPI)
+    return;  // set up in `initializeDisplay`
+
+  transport = new MBED_SPI_TRANSPORT(mbedSPI);
+  flusher = new Flusher(transport, FRAME_BYTES);
+}
+
+void MBED_SPI_DRIVER::waitForFlush() {
+  if (flusher)
+    flusher->waitForFlush();
+}
+
+bool MBED_SPI_DRIVER::isFlushing() {
+  return flusher && flusher->isFlushing();
+}
+
+void MBED_SPI_DRIVER::sendBufferToDisplayAsync() {
+  uint8_t *frame = flusher->acquire();  // fence on the previous frame
+  uint16_t length = 0;
+
+  linesSent = 0;
+
+  frame[length++] = vcom | writeCommand;
+
+  for (uint8_t i = 0; i < sizeof(MBED_SPI_DRIVER_DIRTY_LINES); i++) {
+    uint8_t dirtyLines = MBED_SPI_DRIVER_DIRTY_LINES[i];
+    if (!dirtyLines)
+      continue;
+
+    const uint8_t *lines = getPhysicalLines(i);
+
+    for (uint8_t bit = 0; bit < 8; bit++) {
+      if (!(dirtyLines & (1 << bit)))
+        continue;
+
+      int line = 8 * i + bit;
+      frame[length++] = reverse(line + 1);
+      memcpy(frame + length, lines + 18 * bit, 18);
+      length += 18;
+      frame[length++] = 0x00;
+      linesSent++;
+    }
+
+    MBED_SPI_DRIVER_DIRTY_LINES[i] = 0x00;
+  }
+
+  if (!linesSent)
+    frame[0] = vcom;  // display mode command, only toggles vcom
+
+  frame[length++] = 0x00;
+
+  vcom = vcom ? 0x00 : vcomCommand;
+
+  flusher->submit(length);
 }
 
 void MBED_SPI_DRIVER::sendBufferToDisplay() {
+  if (flusher) {
+    sendBufferToDisplayAsync();
+    return;
+  }
+
   mbedSPI->lock();
   digitalWrite(KYWY_DISPLAY_CS, HIGH);
 
-  mbedSPI->write(vcom | writeCommand);
-  vcom = vcom ? 0x00 : vcomCommand;  // toggle vcom at least 1 time per second to
-                                     // prevent DC bias
+  linesSent = 0;
+
+  bool dirty = false;
+  for (uint8_t i = 0; i < sizeof(MBED_SPI_DRIVER_DIRTY_LINES); i++) {
+    if (MBED_SPI_DRIVER_DIRTY_LINES[i]) {
+      dirty = true;
+      break;
+    }
+  }
+
+  if (dirty) {
+    // multi-line write: command, then (address, data, dummy byte) for each
+    // changed line, then a trailing dummy byte
+    mbedSPI->write(vcom | writeCommand);
+
+    for (uint8_t i = 0; i < sizeof(MBED_SPI_DRIVER_DIRTY_LINES); i++) {
+      uint8_t dirtyLines = MBED_SPI_DRIVER_DIRTY_LINES[i];
+      if (!dirtyLines)
+        continue;  // skip 8 clean lines at a time
+
+      const uint8_t *lines = getPhysicalLines(i);
+
+      for (uint8_t bit = 0; bit < 8; bit++) {
+        if (!(dirtyLines & (1 << bit)))
+          continue;
+
+        int line = 8 * i + bit;
+        MBED_SPI_DRIVER_LINE_BUFFER[0] = reverse(line + 1);
+        memcpy((void *)(MBED_SPI_DRIVER_LINE_BUFFER + 1),
+               (const void *)(lines + 18 * bit), 18);
+        MBED_SPI_DRIVER_LINE_BUFFER[19] = 0x00;
+        mbedSPI->write((const char *)MBED_SPI_DRIVER_LINE_BUFFER, 20,
+                       (char *)MBED_SPI_DRIVER_RX_BUFFER, 20);
+        linesSent++;
+      }
 
-  for (int line = 0; line < 168; line++) {
-    MBED_SPI_DRIVER_LINE_BUFFER[0] = reverse(line + 1);
-    memcpy((void *)(MBED_SPI_DRIVER_LINE_BUFFER + 1),
-           (const void *)(MBED_SPI_DRIVER_BUFFER + 18 * line), 18);
-    MBED_SPI_DRIVER_LINE_BUFFER[19] = 0x00;
-    mbedSPI->write((const char *)MBED_SPI_DRIVER_LINE_BUFFER, 20,
-                   (char *)MBED_SPI_DRIVER_RX_BUFFER, 20);
+      MBED_SPI_DRIVER_DIRTY_LINES[i] = 0x00;
+    }
+  } else {
+    // nothing changed, but the write is also how we toggle vcom so send a
+    // display mode command (M0 == 0) that only carries the vcom bit
+    mbedSPI->write(vcom);
   }
   mbedSPI->write(0x00);
 
+  vcom = vcom ? 0x00 : vcomCommand;  // toggle vcom at least 1 time per second to
+                                     // prevent DC bias
+
   digitalWrite(KYWY_DISPLAY_CS, LOW);
   mbedSPI->unlock();
 }
 
 void MBED_SPI_DRIVER::setBufferPixel(int16_t x, int16_t y, uint16_t color) {
-  if (x < 0 || x >= 144 || y < 0 || y >= 168) {
+  if (x < 0 || x >= rotatedWidth || y < 0 || y >= rotatedHeight || isClipped(x, y)) {
     return;
   }
 
-  int index = (18 * y) + (x / 8);
+  int index = (stride * y) + (x / 8);
   int bit = x % 8;
 
+  markBlockDirty(x, y, 1, 1);
+
   if (color) {
     MBED_SPI_DRIVER_BUFFER[index] =
       MBED_SPI_DRIVER_BUFFER[index] | (1 << (7 - bit));
@@ -84,185 +358,377 @@ void MBED_SPI_DRIVER::setBufferPixel(int16_t x, int16_t y, uint16_t color) {
   }
 }
 
+uint16_t MBED_SPI_DRIVER::getBufferPixel(int16_t x, int16_t y) {
+  if (x < 0 || x >= rotatedWidth || y < 0 || y >= rotatedHeight) {
+    return 0xff;
+  }
+
+  int index = (stride * y) + (x / 8);
+  int bit = x % 8;
+
+  return MBED_SPI_DRIVER_BUFFER[index] & (1 << (7 - bit)) ? 0xff : 0x00;
+}
+
+void Driver::setBufferSpans(const Span *spans, uint16_t count, uint16_t color) {
+  for (uint16_t i = 0; i < count; i++) {
+    setBufferBlock(spans[i].left, spans[i].y, spans[i].right - spans[i].left + 1, 1, color);
+  }
+}
+
 bool Driver::cropBlock(int16_t &x, int16_t &y, uint16_t &width,
                        uint16_t &height) {
-  if (x > (getWidth() - 1) || y > (getHeight() - 1) || x + width - 1 < 0 || y + height - 1 < 0)
+  int32_t left = x > clipX ? x : clipX;
+  int32_t top = y > clipY ? y : clipY;
+  int32_t right = (int32_t)x + width;
+  int32_t bottom = (int32_t)y + height;
+
+  if (left < 0)
+    left = 0;
+  if (top < 0)
+    top = 0;
+  if (right > clipRight)
+    right = clipRight;
+  if (bottom > clipBottom)
+    bottom = clipBottom;
+  if (right > getWidth())
+    right = getWidth();
+  if (bottom > getHeight())
+    bottom = getHeight();
+
+  if (left >= right || top >= bottom)
     return false;
 
-  if (x < 0) {
-    width += x;
-    x = 0;
+  x = left;
+  y = top;
+  width = right - left;
+  height = bottom - top;
+
+  return true;
+}
+
+// The blit kernels below write one row at a time. Source bits are funneled
+// through a 32-bit reservoir so every destination byte is a single shift
+// instead of two unaligned reads, and the edge masks are computed once per
+// blit since every row shares the same left and right edge. Destination
+// writes stay bytewise: rows are 18 (or 21 when rotated) bytes apart so they
+// aren't word aligned, and the RP2040 can't do unaligned word access.
+//
+// `BlitMode` folds the opaque/transparent x color x negative combinations
+// down to three write operations on the (already flipped) source byte.
+enum class BlitMode {
+  OPAQUE,  // copy source bits
+  SET,     // transparent, set bits where the source is set
+  CLEAR,   // transparent, clear bits where the source is clear
+};
+
+template<BlitMode mode>
+static inline void blitByte(uint8_t *buffer, uint8_t source, uint8_t mask) {
+  switch (mode) {
+    case BlitMode::OPAQUE:
+      *buffer = (*buffer & ~mask) | (source & mask);
+      break;
+    case BlitMode::SET:
+      *buffer |= source & mask;
+      break;
+    case BlitMode::CLEAR:
+      *buffer &= source | ~mask;
+      break;
+  }
+}
+
+template<BlitMode mode>
+static inline void blitWholeByte(uint8_t *buffer, uint8_t source) {
+  switch (mode) {
+    case BlitMode::OPAQUE:
+      *buffer = source;
+      break;
+    case BlitMode::SET:
+      *buffer |= source;
+      break;
+    case BlitMode::CLEAR:
+      *buffer &= source;
+      break;
+  }
+}
+
+// MSB aligned queue of upcoming bitmap bits for one row
+struct BitReservoir {
+  const uint8_t *source;
+  const uint8_t *sourceEnd;
+  uint32_t bits;
+  int8_t count;
+
+  // `padding` zero bits are queued ahead of the first bitmap bit so the stream
+  // lines up with the buffer's byte columns
+  BitReservoir(const uint8_t *bitmap, uint32_t bitIndex, uint16_t width,
+               uint8_t padding) {
+    source = bitmap + bitIndex / 8;
+    sourceEnd = bitmap + (bitIndex + width + 7) / 8;  // never read past the row
+    bits = (((uint32_t)*source++ << 24) << (bitIndex % 8)) >> padding;
+    count = 8 - bitIndex % 8 + padding;
   }
 
-  if ((x + width - 1) > (getWidth() - 1)) {
-    width = getWidth() - x;
+  inline uint8_t next() {
+    while (count < 8 && source < sourceEnd) {
+      bits |= (uint32_t)*source++ << (24 - count);
+      count += 8;
+    }
+    uint8_t byte = bits >> 24;
+    bits <<= 8;
+    count -= 8;
+    return byte;
   }
+};
 
-  if (y < 0) {
-    height += y;
-    y = 0;
+static inline void getColumnMasks(uint8_t leftSkip, uint16_t width,
+                                  uint16_t &columns, uint8_t &leftMask,
+                                  uint8_t &rightMask) {
+  columns = (leftSkip + width + 7) / 8;
+  leftMask = 0xff >> leftSkip;
+  rightMask = 0xff << ((8 - (leftSkip + width) % 8) % 8);
+  if (columns == 1) {
+    leftMask &= rightMask;
   }
+}
 
-  if ((y + height - 1) > (getHeight() - 1)) {
-    height = getHeight() - y;
+// `buffer` points at the left byte column of the first row, `bitmapBitIndex`
+// at the bitmap bit that lands on the first written pixel
+template<BlitMode mode>
+static void blitRows(uint8_t *buffer, uint8_t stride, uint8_t leftSkip,
+                     uint16_t width, uint16_t height, const uint8_t *bitmap,
+                     uint32_t bitmapBitIndex, uint16_t bitmapWidth,
+                     uint8_t flip) {
+  uint16_t columns;
+  uint8_t leftMask, rightMask;
+  getColumnMasks(leftSkip, width, columns, leftMask, rightMask);
+
+  for (uint16_t j = 0; j < height; j++, buffer += stride, bitmapBitIndex += bitmapWidth) {
+    BitReservoir reservoir(bitmap, bitmapBitIndex, width, leftSkip);
+
+    blitByte<mode>(buffer, reservoir.next() ^ flip, leftMask);
+    if (columns == 1)
+      continue;
+
+    uint8_t *column = buffer + 1;
+    for (uint8_t *lastColumn = buffer + columns - 1; column < lastColumn; column++) {
+      blitWholeByte<mode>(column, reservoir.next() ^ flip);
+    }
+
+    blitByte<mode>(column, reservoir.next() ^ flip, rightMask);
   }
+}
 
-  return true;
+// fast path for a source and destination that both start on a byte boundary,
+// whole bytes are copied straight across with no shifting
+template<BlitMode mode>
+static void blitRowsAligned(uint8_t *buffer, uint8_t stride, uint16_t width,
+                            uint16_t height, const uint8_t *bitmap,
+                            uint16_t bitmapStride, uint8_t flip) {
+  uint16_t wholeBytes = width / 8;
+  uint8_t rightMask = 0xff << (8 - width % 8);
+
+  for (uint16_t j = 0; j < height; j++, buffer += stride, bitmap += bitmapStride) {
+    for (uint16_t i = 0; i < wholeBytes; i++) {
+      blitWholeByte<mode>(buffer + i, bitmap[i] ^ flip);
+    }
+    if (width % 8) {
+      blitByte<mode>(buffer + wholeBytes, bitmap[wholeBytes] ^ flip, rightMask);
+    }
+  }
 }
 
-void MBED_SPI_DRIVER::writeBitmapOrBlockToBuffer(
-  int16_t x, int16_t y, uint16_t width, uint16_t height, uint8_t *bitmap,
-  BitmapOptions options, bool block, uint16_t blockColor) {
+// solid fill, opaque inner columns are a plain memset. The left column gets
+// its own fill byte since the fill pattern is shifted to start at the first
+// written pixel.
+template<BlitMode mode>
+static void fillRows(uint8_t *buffer, uint8_t stride, uint8_t leftSkip,
+                     uint16_t width, uint16_t height, uint8_t leftFill,
+                     uint8_t fill) {
+  uint16_t columns;
+  uint8_t leftMask, rightMask;
+  getColumnMasks(leftSkip, width, columns, leftMask, rightMask);
+
+  for (uint16_t j = 0; j < height; j++, buffer += stride) {
+    blitByte<mode>(buffer, leftFill, leftMask);
+    if (columns == 1)
+      continue;
+
+    if (mode == BlitMode::OPAQUE) {
+      memset(buffer + 1, fill, columns - 2);
+    } else {
+      for (uint16_t i = 1; i < columns - 1; i++) {
+        blitWholeByte<mode>(buffer + i, fill);
+      }
+    }
 
-  // we can write from an arbitrary chunk of the bitmap to an arbitrary chunk of
-  // the screen buffer
-  uint16_t bitmapX = 0, bitmapY = 0, bitmapWidth = width;
+    blitByte<mode>(buffer + columns - 1, fill, rightMask);
+  }
+}
 
-  if (x < 0)
-    bitmapX += -1 * x;  // left edge of bitmap is off screen
+void MBED_SPI_DRIVER::writeBitmapOrBlockToBuffer(
+  int16_t x, int16_t y, uint16_t width, uint16_t height, const uint8_t *bitmap,
+  BitmapOptions options, bool block, uint16_t blockColor,
+  uint16_t bitmapStride, uint32_t bitmapOffset) {
 
-  if (y < 0)
-    bitmapY += -1 * y;  // top edge of bitmap is off screen
+  // we can write from an arbitrary chunk of the bitmap to an arbitrary chunk of
+  // the screen buffer, `bitmapOffset` and `bitmapStride` place the block inside
+  // a larger bitmap
+  uint16_t bitmapWidth = bitmapStride ? bitmapStride : width;
+  int16_t uncroppedX = x, uncroppedY = y;
 
   if (!cropBlock(x, y, width, height))
     return;  // no overlap between bitmap and screen
 
-  // get top left corner of block to write on screen
-  uint8_t *buffer = MBED_SPI_DRIVER_BUFFER + (18 * y) + (x / 8);
+  // whatever was cropped off the top left of the block is skipped in the bitmap
+  uint16_t bitmapX = x - uncroppedX, bitmapY = y - uncroppedY;
 
-  // index bitmap by bits instead of bytes to handle all the byte splitting
-  uint16_t bitmapBitIndex = bitmapWidth * bitmapY + bitmapX;
-
-  // precomputed values
-  uint8_t bufferBitsNotToWriteToInLeftByteColumn = x % 8;
-  uint8_t bufferBitsToWriteToInLeftByteColumn = 8 - x % 8;
-
-  // buffer wrap distance calculation
-  int splitLeftBits =
-    8 - x % 8;  // how many bits of the left most byte column need to be filled
-  splitLeftBits =
-    splitLeftBits == 8
-      ? 0
-      : splitLeftBits;  // if we have a whole column on the left just include
-                        // it as part of the inner bytes
-  int splitRightBits =
-    (x + width) % 8;  // how many bits of the right most byte column need to be filled
-  uint16_t innerBytes =
-    (width - splitLeftBits - splitRightBits) / 8;  // how many bytes are between the right and left column
-  uint16_t bufferWrapDistance =
-    18 - innerBytes - (splitLeftBits ? 1 : 0) - (splitRightBits ? 1 : 0);
-
-  // iterate over each line
-  for (int16_t j = 0; j < height; j++) {
-    uint16_t bitsLeftToWrite = width;
-
-    while (bitsLeftToWrite) {
-      uint8_t byteToWrite;
-      uint8_t bitsWritten = 0;
-      uint8_t mask =
-        0x00;  // identifies the part of the byte column we want to write
-
-      if (block) {
-        byteToWrite = blockColor;
-      } else {
-        byteToWrite =
-          ((*(bitmap + (bitmapBitIndex / 8)) << (bitmapBitIndex % 8)) | (*(bitmap + (bitmapBitIndex / 8) + 1) >> (8 - bitmapBitIndex % 8)));
-      }
+  markBlockDirty(x, y, width, height);
 
-      if (options.getNegative()) {
-        byteToWrite = ~byteToWrite;
-      }
-
-      // we're only writing a single partial column and need to mask both sides
-      // of the byteToWrite
-      if (bufferBitsToWriteToInLeftByteColumn > width) {
-        byteToWrite =
-          byteToWrite >> bufferBitsNotToWriteToInLeftByteColumn;  // shift starting bitmap bit
-                                                                  // to match starting bit of
-                                                                  // buffer byte column
+  // get top left corner of block to write on screen
+  uint8_t *buffer = MBED_SPI_DRIVER_BUFFER + (stride * y) + (x / 8);
+  uint8_t leftSkip = x % 8;
+
+  // source bytes are xor'd with `flip` before writing, which folds the negative
+  // option and the color into the three write modes
+  uint8_t flip = (options.getNegative() ? 0xff : 0x00) ^ (options.getColor() ? 0xff : 0x00);
+  BlitMode mode = options.getOpaque() ? BlitMode::OPAQUE : (options.getColor() ? BlitMode::SET : BlitMode::CLEAR);
+
+  if (block) {
+    uint8_t fill = (uint8_t)blockColor ^ flip;
+    uint8_t leftFill = ((uint8_t)(blockColor ^ (options.getNegative() ? 0xff : 0x00)) >> leftSkip) ^ (options.getColor() ? 0xff : 0x00);
+    switch (mode) {
+      case BlitMode::OPAQUE:
+        fillRows<BlitMode::OPAQUE>(buffer, stride, leftSkip, width, height, leftFill, fill);
+        break;
+      case BlitMode::SET:
+        fillRows<BlitMode::SET>(buffer, stride, leftSkip, width, height, leftFill, fill);
+        break;
+      case BlitMode::CLEAR:
+        fillRows<BlitMode::CLEAR>(buffer, stride, leftSkip, width, height, leftFill, fill);
+        break;
+    }
+    return;
+  }
 
-        mask =
-          0xff >> bufferBitsNotToWriteToInLeftByteColumn;  // mask of left side since
-                                                           // this is a partial column
-        mask &=
-          0xff
-          << (8 - (bufferBitsNotToWriteToInLeftByteColumn + width));  // mask off right side since this is a partial column
+  // index bitmap by bits instead of bytes to handle all the byte splitting
+  uint32_t bitmapBitIndex = bitmapOffset + (uint32_t)bitmapWidth * bitmapY + bitmapX;
 
-        bitsWritten = width;
+  if (leftSkip == 0 && bitmapBitIndex % 8 == 0 && bitmapWidth % 8 == 0) {
+    const uint8_t *source = bitmap + bitmapBitIndex / 8;
+    switch (mode) {
+      case BlitMode::OPAQUE:
+        blitRowsAligned<BlitMode::OPAQUE>(buffer, stride, width, height, source, bitmapWidth / 8, flip);
+        break;
+      case BlitMode::SET:
+        blitRowsAligned<BlitMode::SET>(buffer, stride, width, height, source, bitmapWidth / 8, flip);
+        break;
+      case BlitMode::CLEAR:
+        blitRowsAligned<BlitMode::CLEAR>(buffer, stride, width, height, source, bitmapWidth / 8, flip);
+        break;
+    }
+    return;
+  }
 
-        // we're on the leftmost column
-      } else if (bitsLeftToWrite == width) {
-        byteToWrite =
-          byteToWrite >> bufferBitsNotToWriteToInLeftByteColumn;  // shift starting bitmap bit
-                                                                  // to match starting bit of
-                                                                  // buffer byte column
+  switch (mode) {
+    case BlitMode::OPAQUE:
+      blitRows<BlitMode::OPAQUE>(buffer, stride, leftSkip, width, height, bitmap, bitmapBitIndex, bitmapWidth, flip);
+      break;
+    case BlitMode::SET:
+      blitRows<BlitMode::SET>(buffer, stride, leftSkip, width, height, bitmap, bitmapBitIndex, bitmapWidth, flip);
+      break;
+    case BlitMode::CLEAR:
+      blitRows<BlitMode::CLEAR>(buffer, stride, leftSkip, width, height, bitmap, bitmapBitIndex, bitmapWidth, flip);
+      break;
+  }
+}
 
-        mask = 0xff >> bufferBitsNotToWriteToInLeftByteColumn;  // mask off left side
+void MBED_SPI_DRIVER::setBufferBlock(int16_t x, int16_t y, uint16_t width,
+                                     uint16_t height, uint16_t color) {
+  writeBitmapOrBlockToBuffer(x, y, width, height, nullptr,
+                             BitmapOptions().opaque(true), true, color);
+}
 
-        bitsWritten = bufferBitsToWriteToInLeftByteColumn;
+// same bytes as `setBufferBlock` with a height of 1, without going through the
+// bitmap path for every row
+void MBED_SPI_DRIVER::setBufferSpans(const Span *spans, uint16_t count, uint16_t color) {
+  // what can be drawn to, the screen within the clip
+  int32_t left = clipX > 0 ? clipX : 0, top = clipY > 0 ? clipY : 0;
+  int32_t right = clipRight < rotatedWidth ? clipRight : rotatedWidth;
+  int32_t bottom = clipBottom < rotatedHeight ? clipBottom : rotatedHeight;
 
-        // we're writing an inner column
-      } else if (bitsLeftToWrite >= 8) {
-        mask = 0xff;  // don't mask off anything
+  uint8_t fill = (uint8_t)color;
 
-        bitsWritten = 8;
+  for (uint16_t i = 0; i < count; i++) {
+    const Span &span = spans[i];
+    if (span.y < top || span.y >= bottom) {
+      continue;
+    }
 
-        // we're writing the rightmost column
-      } else if ((bitsLeftToWrite > 0) & (bitsLeftToWrite < 8)) {
-        mask = 0xff << (8 - bitsLeftToWrite);  // mask off right side
+    int16_t spanLeft = span.left < left ? left : span.left;
+    int16_t spanRight = span.right >= right ? right - 1 : span.right;
+    if (spanLeft > spanRight) {
+      continue;
+    }
 
-        bitsWritten = bitsLeftToWrite;
-      }
+    markBlockDirty(spanLeft, span.y, spanRight - spanLeft + 1, 1);
 
-      // actually do the writing
-      if (!options.getOpaque()) {
-        if (options.getColor()) {
-          *buffer |= (~byteToWrite) & mask;
-        } else {
-          *buffer &= byteToWrite | (~mask);
-        }
-      } else {
-        if (options.getColor()) {
-          *buffer = (*buffer & ~mask) | (~byteToWrite & mask);
-        } else {
-          *buffer = (*buffer & ~mask) | (byteToWrite & mask);
-        }
-      }
+    uint8_t *row = MBED_SPI_DRIVER_BUFFER + (stride * span.y);
+    uint8_t first = spanLeft / 8, last = spanRight / 8;
+    uint8_t leftMask = 0xff >> (spanLeft % 8), rightMask = 0xff << (7 - spanRight % 8);
+    uint8_t leftFill = fill >> (spanLeft % 8);  // the fill pattern starts at the first pixel
 
-      // advance our tracking variables
-      buffer += 1;
-      bitmapBitIndex += bitsWritten;
-      bitsLeftToWrite -= bitsWritten;
+    if (first == last) {
+      leftMask &= rightMask;
+      row[first] = (row[first] & ~leftMask) | (leftFill & leftMask);
+      continue;
     }
 
-    // advance to the next line on the bitmap and buffer
-    bitmapBitIndex += bitmapWidth - width;
-    buffer += bufferWrapDistance;
+    row[first] = (row[first] & ~leftMask) | (leftFill & leftMask);
+    memset(row + first + 1, fill, last - first - 1);
+    row[last] = (row[last] & ~rightMask) | (fill & rightMask);
   }
 }
 
-void MBED_SPI_DRIVER::setBufferBlock(int16_t x, int16_t y, uint16_t width,
-                                     uint16_t height, uint16_t color) {
-  writeBitmapOrBlockToBuffer(x, y, width, height, nullptr,
-                             BitmapOptions().opaque(true), true, color);
-}
-
 void MBED_SPI_DRIVER::writeBitmapToBuffer(int16_t x, int16_t y, uint16_t width,
-                                          uint16_t height, uint8_t *bitmap,
+                                          uint16_t height, const uint8_t *bitmap,
                                           BitmapOptions options) {
   writeBitmapOrBlockToBuffer(x, y, width, height, bitmap, options, false, 0x00);
 }
 
+void MBED_SPI_DRIVER::writeBitmapViewToBuffer(int16_t x, int16_t y, const BitmapView &view,
+                                              BitmapOptions options) {
+  writeBitmapOrBlockToBuffer(x, y, view.width, view.height, view.bitmap, options, false, 0x00,
+                             view.stride, (uint32_t)view.stride * view.y + view.x);
+}
+
 }  // namespace Driver
 
 void Display::setup() {
   driver->initializeDisplay();
 }
 void Display::clear() {
+  driver->lock();
   driver->clearBuffer();
+  driver->unlock();
 }
 void Display::update() {
+  PROFILE_SCOPE(::Profiler::RECORD_UPDATE, 0);
+  driver->lock();
   driver->sendBufferToDisplay();
+  updates++;
+  driver->unlock();
+}
+void Display::lock() {
+  driver->lock();
+}
+void Display::unlock() {
+  driver->unlock();
+}
+void Display::waitForFlush() {
+  driver->waitForFlush();
+}
+bool Display::isFlushing() {
+  return driver->isFlushing();
 }
 void Display::setRotation(Rotation rotation) {
   driver->setRotation(rotation);
@@ -299,6 +765,8 @@ void Display::shiftOrigin2DToTopLeft(Origin::Object2D origin, int16_t &x,
 
 void Display::drawLine(int16_t xStart, int16_t yStart, int16_t xEnd,
                        int16_t yEnd, Object1DOptions options) {
+  PROFILE_SCOPE(::Profiler::RECORD_DRAW, ::Profiler::DRAW_LINE);
+
   if (yStart == yEnd) {   // horizontal line
     if (xEnd < xStart) {  // setBufferBlock draws left-to-right so make sure xEnd
                           // is >= xStart
@@ -356,20 +824,27 @@ void Display::drawLine(int16_t x, int16_t y, double length, double angle,
                        Object1DOptions options) {
   int16_t xStart = 0, yStart = 0, xEnd = 0, yEnd = 0;
 
+  // in fixed point, the only floating point math left is converting the
+  // arguments
+  FixedPoint::Angle fixedAngle = FixedPoint::fromRadians(angle);
+  FixedPoint::Fixed fixedLength = FixedPoint::fromFloat(length);
+  FixedPoint::Fixed dX = FixedPoint::multiply(fixedLength, FixedPoint::cos(fixedAngle));
+  FixedPoint::Fixed dY = FixedPoint::multiply(fixedLength, FixedPoint::sin(fixedAngle));
+
   // multiply y deltas by -1 since our y-axis is inverted compared to standard
   // cartesian coordinates
   switch (options.getOrigin()) {
     case Origin::Object1D::ENDPOINT:
       xStart = x;
       yStart = y;
-      xEnd = round(xStart + length * cos(angle));
-      yEnd = round(yStart + -1 * length * sin(angle));
+      xEnd = FixedPoint::toNearestInt(FixedPoint::fromInt(xStart) + dX);
+      yEnd = FixedPoint::toNearestInt(FixedPoint::fromInt(yStart) + -1 * dY);
       break;
     case Origin::Object1D::MIDPOINT:
-      xStart = round(x - 0.5 * length * cos(angle));
-      yStart = round(y - -1 * 0.5 * length * sin(angle));
-      xEnd = round(x + 0.5 * length * cos(angle));
-      yEnd = round(y + -1 * 0.5 * length * sin(angle));
+      xStart = FixedPoint::toNearestInt(FixedPoint::fromInt(x) - dX / 2);
+      yStart = FixedPoint::toNearestInt(FixedPoint::fromInt(y) - -1 * dY / 2);
+      xEnd = FixedPoint::toNearestInt(FixedPoint::fromInt(x) + dX / 2);
+      yEnd = FixedPoint::toNearestInt(FixedPoint::fromInt(y) + -1 * dY / 2);
       break;
   }
 
@@ -378,6 +853,7 @@ void Display::drawLine(int16_t x, int16_t y, double length, double angle,
 
 void Display::drawRectangle(int16_t x, int16_t y, uint16_t width,
                             uint16_t height, Object2DOptions options) {
+  PROFILE_SCOPE(::Profiler::RECORD_DRAW, ::Profiler::DRAW_RECTANGLE);
   shiftOrigin2DToTopLeft(options.getOrigin(), x, y, width, height);
   driver->setBufferBlock(x, y, width, 1, options.getColor());  // top line
   driver->setBufferBlock(x, y + height - 1, width, 1,
@@ -389,14 +865,24 @@ void Display::drawRectangle(int16_t x, int16_t y, uint16_t width,
 
 void Display::fillRectangle(int16_t x, int16_t y, uint16_t width,
                             uint16_t height, Object2DOptions options) {
+  PROFILE_SCOPE(::Profiler::RECORD_DRAW, ::Profiler::FILL_RECTANGLE);
   shiftOrigin2DToTopLeft(options.getOrigin(), x, y, width, height);
   driver->setBufferBlock(x, y, width, height, options.getColor());
 };
 
 void Display::drawBitmap(int16_t x, int16_t y, uint16_t width, uint16_t height,
-                         uint8_t *bitmap, BitmapOptions options) {
+                         const uint8_t *bitmap, BitmapOptions options) {
+  PROFILE_SCOPE(::Profiler::RECORD_DRAW, ::Profiler::DRAW_BITMAP);
   shiftOrigin2DToTopLeft(options.getOrigin(), x, y, width, height);
   driver->writeBitmapToBuffer(x, y, width, height, bitmap, options);
 };
 
+void Display::drawBitmap(int16_t x, int16_t y, const BitmapView &view,
+                         BitmapOptions options) {
+  PROFILE_SCOPE(::Profiler::RECORD_DRAW, ::Profiler::DRAW_BITMAP);
+  uint16_t width = view.width, height = view.height;
+  shiftOrigin2DToTopLeft(options.getOrigin(), x, y, width, height);
+  driver->writeBitmapViewToBuffer(x, y, view, options);
+};
+
 }  // namespace Display
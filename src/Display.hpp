@@ -5,6 +5,8 @@
 #ifndef KYWY_LIB_DISPLAY
 #define KYWY_LIB_DISPLAY 1
 
+#include "FixedPoint.hpp"
+#include "Flush.hpp"
 #include "Fonts.hpp"
 #include <Arduino.h>
 #include <SPIMaster.h>
@@ -111,7 +113,7 @@ struct Object2DOptions {
 struct TextOptions {
   uint16_t _color = 0x00;
   Origin::Text _origin = Origin::Text::TOP_LEFT;
-  uint8_t *_font = nullptr;
+  const uint8_t *_font = nullptr;
   bool _opaque = false;
 
   TextOptions color(uint16_t setColor) {
@@ -130,11 +132,11 @@ struct TextOptions {
     return _origin;
   };
 
-  TextOptions font(uint8_t *setFont) {
+  TextOptions font(const uint8_t *setFont) {
     _font = setFont;
     return *this;
   };
-  uint8_t *getFont() {
+  const uint8_t *getFont() {
     return _font;
   };
 
@@ -186,6 +188,20 @@ struct BitmapOptions {
   };
 };
 
+// a rectangle inside a larger bitmap, e.g. a frame of a sprite sheet, that is
+// drawn straight out of the bitmap instead of being copied out first
+struct BitmapView {
+  const uint8_t *bitmap = nullptr;
+  uint16_t x = 0, y = 0;  // top left corner of the rectangle in the bitmap
+  uint16_t width = 0, height = 0;
+  uint16_t stride = 0;  // bits per row of the bitmap, i.e. its width
+};
+
+// a run of pixels on one row, `left` and `right` are both drawn
+struct Span {
+  int16_t left, right, y;
+};
+
 namespace Driver {
 
 struct PinMap {
@@ -211,37 +227,110 @@ public:
   virtual void clearBuffer() = 0;
   virtual void sendBufferToDisplay() = 0;
 
+  // drivers that flush in the background override these, by default flushes
+  // are synchronous and there is never anything to wait on
+  virtual void waitForFlush() {}
+  virtual bool isFlushing() {
+    return false;
+  };
+
   virtual void setRotation(Rotation rotation) = 0;
 
+  // guards the frame buffer between threads, recursive
+  void lock() {
+    bufferMutex.lock();
+  };
+  void unlock() {
+    bufferMutex.unlock();
+  };
+
   // set a single pixel
   virtual void setBufferPixel(int16_t x, int16_t y, uint16_t color) = 0;
 
+  // read a single pixel back, for debugging, drivers that can't read their
+  // buffer report white
+  virtual uint16_t getBufferPixel(int16_t x, int16_t y) {
+    return 0xff;
+  };
+
   // set a rectangle to a single color
   virtual void setBufferBlock(int16_t x, int16_t y, uint16_t width,
                               uint16_t height, uint16_t color) = 0;
 
+  // set runs of pixels to a single color, shapes hand all their spans over in
+  // a few calls instead of a call per pixel or row. Virtual since `Display`
+  // only knows the base class, it's one call per batch of spans and the fill
+  // itself makes no further virtual calls on `MBED_SPI_DRIVER`
+  virtual void setBufferSpans(const Span *spans, uint16_t count, uint16_t color);
+
   // writes a bitmap to the buffer
   virtual void writeBitmapToBuffer(int16_t x, int16_t y, uint16_t width,
-                                   uint16_t height, uint8_t *bitmap,
+                                   uint16_t height, const uint8_t *bitmap,
                                    BitmapOptions options = BitmapOptions()) = 0;
 
+  // writes a rectangle of a larger bitmap to the buffer, the rectangle can
+  // start at any bit
+  virtual void writeBitmapViewToBuffer(int16_t x, int16_t y, const BitmapView &view,
+                                       BitmapOptions options = BitmapOptions()) = 0;
+
+  // limits every write to a rectangle of the screen until `clearClip`, so part
+  // of the screen can be repainted without touching the rest
+  void setClip(int16_t x, int16_t y, uint16_t width, uint16_t height) {
+    clipX = x;
+    clipY = y;
+    clipRight = x + width;
+    clipBottom = y + height;
+  };
+  void clearClip() {
+    clipX = clipY = INT16_MIN;
+    clipRight = clipBottom = INT16_MAX;
+  };
+
 protected:
-  // crops a block within the screen bounds, returns false if the block doesn't
-  // overlap with the screen
+  int16_t clipX = INT16_MIN, clipY = INT16_MIN;
+  int32_t clipRight = INT16_MAX, clipBottom = INT16_MAX;  // exclusive
+
+  bool isClipped(int16_t x, int16_t y) {
+    return x < clipX || y < clipY || x >= clipRight || y >= clipBottom;
+  };
+
+  // crops a block within the screen bounds and the clip rectangle, returns
+  // false if the block doesn't overlap with them
   bool cropBlock(int16_t &x, int16_t &y, uint16_t &width, uint16_t &height);
+
+private:
+  rtos::Mutex bufferMutex;
+};
+
+// streams frames over an mbed SPI peripheral, in the background when the
+// target supports asynchronous SPI and blocking otherwise
+class MBED_SPI_TRANSPORT : public Transport {
+public:
+  MBED_SPI_TRANSPORT(mbed::SPI *mbedSPI);
+
+  void writeAsync(const uint8_t *data, uint16_t length, Flusher *flusher);
+  void idle();
+
+private:
+  mbed::SPI *mbedSPI;
+  Flusher *pending = nullptr;
+
+  void onTransferComplete(int event);
 };
 
 class MBED_SPI_DRIVER : public Driver {
 public:
+  // dimensions of the rotated drawing area
   uint16_t getWidth() {
-    return 144;
+    return rotatedWidth;
   };
   uint16_t getHeight() {
-    return 168;
+    return rotatedHeight;
   };
 
   MBED_SPI_DRIVER() {}
   ~MBED_SPI_DRIVER() {
+    setDoubleBuffering(false);
     delete mbedSPI;
   };
 
@@ -249,25 +338,43 @@ public:
   void clearBuffer();
   void sendBufferToDisplay();
 
+  // When enabled `sendBufferToDisplay` copies the changed lines into a front
+  // buffer and returns while the front buffer streams out, so drawing into
+  // the frame buffer can continue right away. Costs an extra ~3.3KB of RAM.
+  void setDoubleBuffering(bool enabled);
+  void waitForFlush();
+  bool isFlushing();
+
   void setRotation(Rotation rotation);
 
   void setBufferPixel(int16_t x, int16_t y, uint16_t color);
+  uint16_t getBufferPixel(int16_t x, int16_t y);
 
   void writeBitmapOrBlockToBuffer(int16_t x, int16_t y, uint16_t width,
-                                  uint16_t height, uint8_t *bitmap,
+                                  uint16_t height, const uint8_t *bitmap,
                                   BitmapOptions options = BitmapOptions(),
                                   bool block = false,
-                                  uint16_t blockColor = 0x00);
+                                  uint16_t blockColor = 0x00,
+                                  uint16_t bitmapStride = 0,
+                                  uint32_t bitmapOffset = 0);
 
   // inherits from the utility function above
   void setBufferBlock(int16_t x, int16_t y, uint16_t width, uint16_t height,
                       uint16_t color);
   void writeBitmapToBuffer(int16_t x, int16_t y, uint16_t width,
-                           uint16_t height, uint8_t *bitmap,
+                           uint16_t height, const uint8_t *bitmap,
                            BitmapOptions options = BitmapOptions());
+  void writeBitmapViewToBuffer(int16_t x, int16_t y, const BitmapView &view,
+                               BitmapOptions options = BitmapOptions());
+  void setBufferSpans(const Span *spans, uint16_t count, uint16_t color);
+
+  // number of lines clocked out by the last call to `sendBufferToDisplay`
+  uint16_t getLinesSent() {
+    return linesSent;
+  };
 
 private:
-  mbed::SPI *mbedSPI;
+  mbed::SPI *mbedSPI = nullptr;
   uint8_t clearCommand = 0x20;
   uint8_t writeCommand = 0x80;
 
@@ -278,6 +385,43 @@ private:
   uint8_t MBED_SPI_DRIVER_LINE_BUFFER[20] = { 0 };
   uint8_t MBED_SPI_DRIVER_RX_BUFFER[20] = { 0 };
 
+  // one bit per line, lines that changed since the last flush and need to be
+  // sent to the display
+  uint8_t MBED_SPI_DRIVER_DIRTY_LINES[168 / 8] = { 0 };
+  // one bit per line, lines that have been drawn to since the last clear (all
+  // other lines are known to be blank), start with everything set since the
+  // buffer isn't blank until the first clear
+  uint8_t MBED_SPI_DRIVER_DRAWN_LINES[168 / 8] = {
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff
+  };
+  uint16_t linesSent = 0;
+
+  // command byte, (address, 18 data bytes, dummy byte) per line, dummy byte
+  static const uint16_t FRAME_BYTES = 1 + 168 * 20 + 1;
+
+  bool doubleBuffering = false;
+  MBED_SPI_TRANSPORT *transport = nullptr;
+  Flusher *flusher = nullptr;
+
+  void sendBufferToDisplayAsync();
+
+  Rotation rotation = Rotation::DEFAULT;
+  uint16_t rotatedWidth = 144;
+  uint16_t rotatedHeight = 168;
+  uint8_t stride = 18;  // bytes per buffer row in the rotated layout
+
+  // holds 8 physical lines when the rotation means they have to be rebuilt
+  uint8_t MBED_SPI_DRIVER_BAND_BUFFER[8 * 18] = { 0 };
+
+  // mark the physical lines covered by a block (in rotated coordinates) as
+  // changed, expects an already cropped block
+  void markBlockDirty(int16_t x, int16_t y, uint16_t width, uint16_t height);
+
+  // returns physical lines `8 * band` through `8 * band + 7` in display order,
+  // 18 bytes each
+  const uint8_t *getPhysicalLines(uint8_t band);
+
   const unsigned char nibbleFlipper[16] = { 0x0, 0x8, 0x4, 0xc, 0x2, 0xa,
                                             0x6, 0xe, 0x1, 0x9, 0x5, 0xd,
                                             0x3, 0xb, 0x7, 0xf };
@@ -288,6 +432,77 @@ private:
 
 }  // namespace Driver
 
+// maximum number of glyphs a `TextLayout` keeps resolved
+#define TEXT_LAYOUT_CAPACITY 32
+
+// the measurements of a string, see `TextLayout`
+struct TextMetrics {
+  uint16_t width = 0;
+  uint16_t height = 0;
+  uint16_t baselineLength = 0;
+
+  // offset of the font origin from the top left corner of the bounding box
+  int16_t originXOffset = 0;
+  int16_t originYOffset = 0;
+};
+
+// A string that has been decoded, had its glyphs looked up and been measured
+// once, and can then be drawn any number of times. Useful for text that
+// changes rarely but is drawn every frame, like a score. At about 400 bytes
+// it's meant to be kept, `drawText` and `getTextSize` with a plain string
+// don't use one.
+//
+// Only the first TEXT_LAYOUT_CAPACITY glyphs are kept. Longer strings are
+// still measured in full, but the rest of the string is read again when it's
+// drawn, so it has to outlive the layout.
+class TextLayout {
+public:
+  struct Glyph {
+    const uint8_t *bitmap;
+    uint16_t code;
+    uint8_t bbxWidth;
+    uint8_t bbxHeight;
+    int8_t bbxXOffset;
+    int8_t bbxYOffset;
+    uint8_t deviceWidthX;
+  };
+
+  TextLayout() {}
+
+  uint16_t getWidth() {
+    return metrics.width;
+  };
+  uint16_t getHeight() {
+    return metrics.height;
+  };
+  uint16_t getBaselineLength() {
+    return metrics.baselineLength;
+  };
+
+  uint8_t getNumGlyphs() {
+    return numGlyphs;
+  };
+  const Glyph &getGlyph(uint8_t glyph) {
+    return glyphs[glyph];
+  };
+
+  // true if the string had more glyphs than the layout could keep
+  bool isTruncated() {
+    return overflow != nullptr;
+  };
+
+private:
+  friend class Display;
+
+  const uint8_t *font = nullptr;
+
+  Glyph glyphs[TEXT_LAYOUT_CAPACITY];
+  uint8_t numGlyphs = 0;
+  const char *overflow = nullptr;  // first character that didn't fit
+
+  TextMetrics metrics;
+};
+
 class Display {
 public:
   Display() {}
@@ -298,6 +513,23 @@ public:
   void clear();
   void update();
 
+  // number of times `update` was called
+  uint32_t getUpdates() {
+    return updates;
+  };
+
+  // Actors that run without the shared handler lock (see
+  // `Actor::Actor::setHandlerLock`) should hold this from `clear` through
+  // `update` so a frame isn't sent while another actor is halfway through
+  // drawing it. `clear` and `update` take it themselves.
+  void lock();
+  void unlock();
+
+  // blocks until the last `update` has reached the display, only matters when
+  // the driver flushes in the background
+  void waitForFlush();
+  bool isFlushing();
+
   void setRotation(Rotation rotation);
 
   void drawPixel(int16_t x, int16_t y, uint16_t color = 0x00);
@@ -312,33 +544,61 @@ public:
   void fillCircle(int16_t x, int16_t y, uint16_t diameter,
                   Object2DOptions options = Object2DOptions());
 
+  // the part of a circle's outline going counterclockwise from `start` to
+  // `end`, angles start pointing right like `drawLine`'s, equal angles draw
+  // the whole outline
+  void drawArc(int16_t x, int16_t y, uint16_t diameter, FixedPoint::Angle start,
+               FixedPoint::Angle end, Object2DOptions options = Object2DOptions());
+
+  void drawEllipse(int16_t x, int16_t y, uint16_t width, uint16_t height,
+                   Object2DOptions options = Object2DOptions());
+  void fillEllipse(int16_t x, int16_t y, uint16_t width, uint16_t height,
+                   Object2DOptions options = Object2DOptions());
+
   void drawRectangle(int16_t x, int16_t y, uint16_t width, uint16_t height,
                      Object2DOptions options = Object2DOptions());
   void fillRectangle(int16_t x, int16_t y, uint16_t width, uint16_t height,
                      Object2DOptions options = Object2DOptions());
 
+  // corners are quarter circles of `radius`, up to half the shorter side
+  void drawRoundedRectangle(int16_t x, int16_t y, uint16_t width, uint16_t height,
+                            uint16_t radius, Object2DOptions options = Object2DOptions());
+  void fillRoundedRectangle(int16_t x, int16_t y, uint16_t width, uint16_t height,
+                            uint16_t radius, Object2DOptions options = Object2DOptions());
+
   void drawBitmap(int16_t x, int16_t y, uint16_t width, uint16_t height,
-                  uint8_t *bitmap, BitmapOptions options = BitmapOptions());
+                  const uint8_t *bitmap, BitmapOptions options = BitmapOptions());
+  void drawBitmap(int16_t x, int16_t y, const BitmapView &view,
+                  BitmapOptions options = BitmapOptions());
 
   void drawText(int16_t x, int16_t y, const char *text,
                 TextOptions options = TextOptions());
   void getTextSize(const char *text, uint16_t &width, uint16_t &height,
                    TextOptions options = TextOptions());
-  void setFont(uint8_t *font);
+  void setFont(const uint8_t *font);
+
+  // lay a string out once and draw it many times, the font is picked when the
+  // layout is made so the font option is ignored when drawing
+  void layoutText(TextLayout &layout, const char *text,
+                  TextOptions options = TextOptions());
+  void drawText(int16_t x, int16_t y, TextLayout &layout,
+                TextOptions options = TextOptions());
 
   Driver::Driver *driver;
 
 private:
-  uint8_t *defaultFont = Font::intel_one_mono_8_pt;
-
-  void drawCircleWithEvenDiameterFromTopLeftCorner(int16_t x, int16_t y,
-                                                   uint16_t diameter,
-                                                   uint16_t color, bool fill);
-  void drawCircleWithOddDiameterFromCenter(int16_t x, int16_t y,
-                                           uint16_t diameter, uint16_t color,
-                                           bool fill);
+  const uint8_t *defaultFont = Font::intel_one_mono_8_pt;
+  uint32_t updates = 0;
+
+  // collects the rows of a round shape as spans, see Circle.cpp
+  class SpanWriter;
+
   void drawOrFillCircle(Origin::Object2D origin, int16_t x, int16_t y,
-                        uint16_t diameter, uint16_t color, bool fill);
+                        uint16_t diameter, SpanWriter &writer);
+  void rasterizeCircle(SpanWriter &writer, int16_t radius, int16_t threshold);
+  void rasterizeEllipse(SpanWriter &writer, uint16_t width, uint16_t height);
+  void rasterizeRoundedRectangle(SpanWriter &writer, int16_t x, int16_t y,
+                                 uint16_t width, uint16_t height, uint16_t radius);
 
   void shiftOrigin2DToTopLeft(Origin::Object2D origin, int16_t &x, int16_t &y,
                               uint16_t width, uint16_t height);
@@ -347,11 +607,17 @@ private:
   // however many bytes the character spans
   uint16_t readUTF8Char(const char *&string);
 
-  // also sets the font origin X and Y offset from the top left corner of the
-  // string bounding box
-  void getTextSize(uint8_t *fontData, const char *text, uint16_t &width,
-                   uint16_t &height, int16_t &originXOffset,
-                   int16_t &originYOffset, uint16_t &baselineLength);
+  // measures `text` in one pass, and keeps its first glyphs in `layout` if
+  // there is one
+  void measureText(TextMetrics &metrics, const uint8_t *font, const char *text,
+                   TextLayout *layout = nullptr);
+  // draws the already looked up `glyphs` and then looks up and draws `rest`
+  void drawMeasuredText(int16_t x, int16_t y, const TextMetrics &metrics,
+                        const uint8_t *font, const TextLayout::Glyph *glyphs,
+                        uint8_t numGlyphs, const char *rest,
+                        TextOptions options);
+  void drawGlyph(int16_t x, int16_t y, const TextLayout::Glyph &glyph,
+                 uint16_t color);
 };
 
 }  // namespace Display
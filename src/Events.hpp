@@ -11,6 +11,7 @@ typedef enum : int {
   // Clock Events
   TICK,
   SET_TICK_DURATION,
+  CLOCK_STEP,  // sent by the clock to itself while free running
 
   // Input Events
   INPUT,          // used for "any button" interactions
@@ -31,11 +32,20 @@ typedef enum : int {
   D_PAD_DOWN_RELEASED,
   D_PAD_CENTER_PRESSED,
   D_PAD_CENTER_RELEASED,
+  INPUT_STATE,      // every tick, carries a `Kywy::InputState`, only sent to actors that subscribe to it by name
+  REPLAY_FINISHED,  // the input log passed to `Input::startReplay` ran out
+  INPUT_CAPTURED,   // sent by the input actor to itself when interrupts captured presses or releases
 
   // Scene Events
   SCENE_ENTER,
   SCENE_EXIT,
 
+  // Console Events
+  CONSOLE_POLL,  // sent to the console actor to check for serial input
+
+  // Collision Events
+  COLLISION,  // published by a `Collider` once per check that found overlaps, carries a `CollisionCheck`
+
   // User Event Boundary
   USER_EVENTS,
 
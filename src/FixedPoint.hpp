@@ -0,0 +1,97 @@
+// SPDX-FileCopyrightText: 2025 KOINSLOT, Inc.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef KYWY_LIB_FIXED_POINT
+#define KYWY_LIB_FIXED_POINT 1
+
+#include <stdint.h>
+
+// Integer math for drawing and gameplay. The RP2040 has no FPU, so every float
+// or double operation is a library call, and `sin`, `cos` and `sqrt` take
+// thousands of cycles. These take tens.
+//
+//   FixedPoint::Angle heading = FixedPoint::fromDegrees(90);
+//   FixedPoint::Fixed dx = FixedPoint::multiply(speed, FixedPoint::cos(heading));
+//   x += FixedPoint::toInt(dx);
+namespace FixedPoint {
+
+// Q16.16: 16 integer bits and 16 fraction bits, from -32768 up to just under
+// 32768 in steps of 1/65536
+typedef int32_t Fixed;
+
+// binary angle: a full turn is 65536, so angles wrap around on their own,
+// counterclockwise from the positive x axis like `sin` and `cos`
+typedef uint16_t Angle;
+
+#define FIXED_ONE ((FixedPoint::Fixed)0x10000)
+#define ANGLE_QUARTER_TURN ((FixedPoint::Angle)0x4000)
+#define ANGLE_HALF_TURN ((FixedPoint::Angle)0x8000)
+
+constexpr Fixed fromInt(int32_t value) {
+  return value * FIXED_ONE;
+};
+
+// for constants, converting at run time is a floating point multiply
+constexpr Fixed fromFloat(double value) {
+  return (Fixed)(value * FIXED_ONE + (value < 0 ? -0.5 : 0.5));
+};
+
+// rounds down
+constexpr int32_t toInt(Fixed value) {
+  return value >> 16;
+};
+
+// rounds to the nearest integer, halves away from zero like `round`
+constexpr int32_t toNearestInt(Fixed value) {
+  return value < 0 ? -((-value + FIXED_ONE / 2) >> 16) : (value + FIXED_ONE / 2) >> 16;
+};
+
+constexpr float toFloat(Fixed value) {
+  return value / (float)FIXED_ONE;
+};
+
+constexpr Fixed multiply(Fixed a, Fixed b) {
+  return (Fixed)(((int64_t)a * b) >> 16);
+};
+
+// `b` can't be 0
+constexpr Fixed divide(Fixed a, Fixed b) {
+  return (Fixed)(((int64_t)a * FIXED_ONE) / b);
+};
+
+constexpr Angle fromDegrees(int32_t degrees) {
+  return (Angle)(((int64_t)degrees * 65536) / 360);
+};
+
+constexpr int32_t toDegrees(Angle angle) {
+  return ((int32_t)angle * 360 + 32768) >> 16;
+};
+
+// for constants, converting at run time is a floating point multiply
+constexpr Angle fromRadians(double radians) {
+  return (Angle)(int32_t)(radians * (32768 / 3.14159265358979323846) + (radians < 0 ? -0.5 : 0.5));
+};
+
+// interpolated from a table of a quarter turn in 256 steps, within 2/65536 of
+// libm
+Fixed sin(Angle angle);
+Fixed cos(Angle angle);
+
+// angle from the positive x axis to (x, y), 0 for (0, 0), within 2/65536 of
+// a turn of libm
+Angle atan2(Fixed y, Fixed x);
+
+// rounded down, e.g. `squareRoot(x * x + y * y)` for integer lengths
+uint32_t squareRoot(uint32_t value);
+uint32_t squareRoot64(uint64_t value);
+
+// within 1/65536, negative values give 0
+Fixed sqrt(Fixed value);
+
+// length of (x, y), which has to be under 32768
+Fixed length(Fixed x, Fixed y);
+
+}  // namespace FixedPoint
+
+#endif
@@ -0,0 +1,49 @@
+// SPDX-FileCopyrightText: 2025 KOINSLOT, Inc.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "Flush.hpp"
+
+namespace Display::Driver {
+
+Flusher::Flusher(Transport *transport, uint16_t capacity)
+  : transport(transport), capacity(capacity) {
+  front = new uint8_t[capacity];
+}
+
+Flusher::~Flusher() {
+  waitForFlush();
+  delete[] front;
+}
+
+uint8_t *Flusher::acquire() {
+  // the front buffer is still being read by the transport until it completes
+  waitForFlush();
+  return front;
+}
+
+void Flusher::submit(uint16_t length) {
+  if (length > capacity)
+    length = capacity;
+
+  flushing = true;
+  framesSubmitted++;
+  transport->writeAsync(front, length, this);
+}
+
+bool Flusher::isFlushing() {
+  return flushing;
+}
+
+void Flusher::waitForFlush() {
+  while (flushing) {
+    transport->idle();
+  }
+}
+
+void Flusher::complete() {
+  framesCompleted++;
+  flushing = false;
+}
+
+}  // namespace Display::Driver
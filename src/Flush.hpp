@@ -0,0 +1,80 @@
+// SPDX-FileCopyrightText: 2025 KOINSLOT, Inc.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef KYWY_LIB_FLUSH
+#define KYWY_LIB_FLUSH 1
+
+#include <stdint.h>
+
+namespace Display::Driver {
+
+class Flusher;
+
+// Byte sink that frames are streamed to. Implementations may finish a write
+// in the background (DMA, interrupt driven SPI, a fake on a host, etc.) but
+// must call `flusher->complete()` exactly once for every `writeAsync` call.
+class Transport {
+public:
+  virtual ~Transport() {}
+
+  virtual void writeAsync(const uint8_t *data, uint16_t length,
+                          Flusher *flusher) = 0;
+
+  // called while waiting on an in-flight write, lets the waiting thread yield
+  // and lets fakes complete pending writes
+  virtual void idle() {}
+};
+
+// Owns the front buffer of a double buffered display. A frame is packed into
+// the front buffer and streamed out by a `Transport` while drawing continues
+// into the back buffer (the driver's frame buffer).
+class Flusher {
+public:
+  Flusher(Transport *transport, uint16_t capacity);
+  ~Flusher();
+
+  // waits for any in-flight flush and returns the front buffer, which can
+  // hold `getCapacity()` bytes
+  uint8_t *acquire();
+
+  // starts streaming the first `length` bytes of the front buffer
+  void submit(uint16_t length);
+
+  // returns true while a submitted frame hasn't finished streaming
+  bool isFlushing();
+
+  // blocks until the in-flight frame (if any) has finished streaming
+  void waitForFlush();
+
+  // called by the transport when a write finishes, safe to call from an
+  // interrupt
+  void complete();
+
+  uint16_t getCapacity() {
+    return capacity;
+  };
+
+  // number of frames submitted and completed, useful for checking that the
+  // fence works
+  uint32_t getFramesSubmitted() {
+    return framesSubmitted;
+  };
+  uint32_t getFramesCompleted() {
+    return framesCompleted;
+  };
+
+private:
+  Transport *transport;
+
+  uint8_t *front;
+  uint16_t capacity;
+
+  volatile bool flushing = false;
+  uint32_t framesSubmitted = 0;
+  volatile uint32_t framesCompleted = 0;
+};
+
+}  // namespace Display::Driver
+
+#endif
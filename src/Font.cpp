@@ -4,12 +4,15 @@
 
 #include "Font.hpp"
 #include "Display.hpp"
+#include "Profiler.hpp"
+
+#include <string.h>
 
 namespace Display {
 
 namespace Font {
 
-Character::Character(uint8_t *character) {
+Character::Character(const uint8_t *character) {
   code = ((uint16_t)character[CHARACTER_CODE] * 256U) + character[CHARACTER_CODE + 1];
   bytes = ((uint16_t)character[CHARACTER_BYTES] * 256U) + character[CHARACTER_BYTES + 1];
   deviceWidthX = character[CHARACTER_DEVICE_WIDTH_X];
@@ -22,7 +25,103 @@ Character::Character(uint8_t *character) {
   bitmap = character + CHARACTER_BITMAP;
 };
 
-Font::Font(uint8_t *font) {
+// Indexes are kept for the most recently used fonts. Actors with their own
+// handler lock can draw text at the same time, so every `Font` pins the entry
+// it uses for as long as it exists and pinned entries are never rebuilt.
+// Lookups then read the index without any locking, only finding, pinning and
+// claiming an entry happen with interrupts off. An entry being built is pinned
+// by its builder and has no font yet, so nobody else uses it.
+static GlyphIndex glyphIndexes[FONT_INDEX_CACHE_SIZE];
+static uint32_t glyphIndexUses = 0;
+
+static inline uint16_t readCharacterCode(const uint8_t *character) {
+  return 256U * character[CHARACTER_CODE] + character[CHARACTER_CODE + 1];
+}
+
+static inline uint16_t readCharacterBytes(const uint8_t *character) {
+  return 256U * character[CHARACTER_BYTES] + character[CHARACTER_BYTES + 1];
+}
+
+static void buildGlyphIndex(GlyphIndex *index, const uint8_t *firstCharacter,
+                            uint16_t numCharacters) {
+  memset(index->ascii, 0, sizeof(index->ascii));
+
+  index->checkpointStride = (numCharacters + FONT_INDEX_CHECKPOINTS - 1) / FONT_INDEX_CHECKPOINTS;
+  if (!index->checkpointStride)
+    index->checkpointStride = 1;
+  index->numCheckpoints = 0;
+
+  // first character is always the missing character replacement glyph so skip
+  // it
+  uint16_t offset = readCharacterBytes(firstCharacter);
+
+  for (uint16_t i = 0; i < numCharacters; i++) {
+    const uint8_t *character = firstCharacter + offset;
+    uint16_t code = readCharacterCode(character);
+
+    if (code >= FONT_INDEX_ASCII_FIRST && code <= FONT_INDEX_ASCII_LAST) {
+      index->ascii[code - FONT_INDEX_ASCII_FIRST] = offset;
+    }
+
+    if (i % index->checkpointStride == 0) {
+      index->checkpointCodes[index->numCheckpoints] = code;
+      index->checkpointOffsets[index->numCheckpoints] = offset;
+      index->numCheckpoints++;
+    }
+
+    offset += readCharacterBytes(character);
+  }
+}
+
+// has to be called with interrupts off
+static GlyphIndex *findGlyphIndex(const uint8_t *font) {
+  for (uint8_t i = 0; i < FONT_INDEX_CACHE_SIZE; i++) {
+    if (glyphIndexes[i].font == font) {
+      glyphIndexes[i].lastUsed = ++glyphIndexUses;
+      return &glyphIndexes[i];
+    }
+  }
+  return nullptr;
+}
+
+// returns a pinned index for the font, or nullptr if every entry is pinned by
+// other fonts
+static GlyphIndex *pinGlyphIndex(const uint8_t *font,
+                                 const uint8_t *firstCharacter,
+                                 uint16_t numCharacters) {
+  core_util_critical_section_enter();
+  GlyphIndex *index = findGlyphIndex(font);
+  if (index) {
+    index->users++;
+    core_util_critical_section_exit();
+    return index;
+  }
+
+  index = nullptr;
+  for (uint8_t i = 0; i < FONT_INDEX_CACHE_SIZE; i++) {
+    if (!glyphIndexes[i].users && (!index || glyphIndexes[i].lastUsed < index->lastUsed)) {
+      index = &glyphIndexes[i];
+    }
+  }
+  if (!index) {
+    core_util_critical_section_exit();
+    return nullptr;
+  }
+  index->font = nullptr;
+  index->users = 1;
+  index->lastUsed = ++glyphIndexUses;
+  core_util_critical_section_exit();
+
+  buildGlyphIndex(index, firstCharacter, numCharacters);
+
+  core_util_critical_section_enter();
+  index->font = font;
+  core_util_critical_section_exit();
+  return index;
+}
+
+Font::Font(const uint8_t *font)
+  : font(font) {
   size = font[FONT_SIZE];
   numCharacters =
     ((uint16_t)font[FONT_CHARACTERS] * 256U) + font[FONT_CHARACTERS + 1];
@@ -33,29 +132,91 @@ Font::Font(uint8_t *font) {
   ascent = font[FONT_ASCENT];
   descent = font[FONT_DESCENT];
   firstCharacter = font + FONT_FIRST_CHARACTER;
-};
 
-Character Font::getCharacter(uint16_t character) {
-  uint8_t *currentCharacter = firstCharacter;
+  index = pinGlyphIndex(font, firstCharacter, numCharacters);
+};
 
-  // first character is always the missing character replacement glyph so skip
-  // it
-  currentCharacter += 256U * *(currentCharacter + CHARACTER_BYTES) + *(currentCharacter + CHARACTER_BYTES + 1);
+Font::~Font() {
+  if (index) {
+    core_util_critical_section_enter();
+    index->users--;
+    core_util_critical_section_exit();
+  }
+}
 
-  uint16_t charactersLeft = numCharacters;
+uint16_t Font::findCharacter(uint16_t character) {
+  // the index is pinned, nothing can rebuild it while we read it
+  return index ? searchIndex(*index, character) : walkCharacters(character);
+}
 
-  while (256U * *(currentCharacter) + *(currentCharacter + 1) != character) {
-    charactersLeft--;
-    currentCharacter += 256U * *(currentCharacter + CHARACTER_BYTES) + *(currentCharacter + CHARACTER_BYTES + 1);
+uint16_t Font::searchIndex(const GlyphIndex &glyphIndex, uint16_t character) {
+  if (character >= FONT_INDEX_ASCII_FIRST && character <= FONT_INDEX_ASCII_LAST) {
+    return glyphIndex.ascii[character - FONT_INDEX_ASCII_FIRST];
+  }
 
-    if (charactersLeft <= 0) {  // if we didn't find the character use the
-                                // missing character replacement glyph
-      printf("Char not found! '%#x'\n", character);
-      return Character(firstCharacter);
+  // characters are sorted by code, find the last checkpoint at or before the
+  // character
+  int16_t low = 0, high = glyphIndex.numCheckpoints - 1, checkpoint = -1;
+  while (low <= high) {
+    int16_t middle = (low + high) / 2;
+    if (glyphIndex.checkpointCodes[middle] <= character) {
+      checkpoint = middle;
+      low = middle + 1;
+    } else {
+      high = middle - 1;
     }
   }
 
-  return Character(currentCharacter);
+  if (checkpoint < 0)
+    return 0;
+
+  // then walk forward, the character must be before the next checkpoint
+  uint16_t offset = glyphIndex.checkpointOffsets[checkpoint];
+  uint16_t charactersLeft = numCharacters - checkpoint * glyphIndex.checkpointStride;
+  for (uint16_t i = 0; i < glyphIndex.checkpointStride && i < charactersLeft; i++) {
+    const uint8_t *currentCharacter = firstCharacter + offset;
+    uint16_t code = readCharacterCode(currentCharacter);
+
+    if (code == character)
+      return offset;
+    if (code > character)
+      break;
+
+    offset += readCharacterBytes(currentCharacter);
+  }
+
+  return 0;
+}
+
+// without an index, only while more fonts than FONT_INDEX_CACHE_SIZE are in
+// use at once
+uint16_t Font::walkCharacters(uint16_t character) {
+  uint16_t offset = readCharacterBytes(firstCharacter);
+  for (uint16_t i = 0; i < numCharacters; i++) {
+    const uint8_t *currentCharacter = firstCharacter + offset;
+    uint16_t code = readCharacterCode(currentCharacter);
+
+    if (code == character)
+      return offset;
+    if (code > character)
+      break;
+
+    offset += readCharacterBytes(currentCharacter);
+  }
+
+  return 0;
+}
+
+Character Font::getCharacter(uint16_t character) {
+  uint16_t offset = findCharacter(character);
+
+  if (!offset) {  // if we didn't find the character use the missing character
+                  // replacement glyph
+    printf("Char not found! '%#x'\n", character);
+    return Character(firstCharacter);
+  }
+
+  return Character(firstCharacter + offset);
 };
 
 }  // namespace Font
@@ -92,85 +253,139 @@ uint16_t Display::readUTF8Char(const char *&string) {
   return firstByte;
 };
 
-void Display::getTextSize(uint8_t *font, const char *text, uint16_t &width,
-                          uint16_t &height, int16_t &originXOffset,
-                          int16_t &originYOffset, uint16_t &baselineLength) {
-  width = 0;
-  height = 0;
-  baselineLength = 0;
+static TextLayout::Glyph toGlyph(const Font::Character &character) {
+  TextLayout::Glyph glyph;
+  glyph.bitmap = character.bitmap;
+  glyph.code = character.code;
+  glyph.bbxWidth = character.bbxWidth;
+  glyph.bbxHeight = character.bbxHeight;
+  glyph.bbxXOffset = character.bbxXOffset;
+  glyph.bbxYOffset = character.bbxYOffset;
+  glyph.deviceWidthX = character.deviceWidthX;
+  return glyph;
+}
+
+void Display::setFont(const uint8_t *font) {
+  defaultFont = font;
+}
+
+void Display::layoutText(TextLayout &layout, const char *text,
+                         TextOptions options) {
+  layout.font = options.getFont() ? options.getFont() : defaultFont;
+  measureText(layout.metrics, layout.font, text, &layout);
+};
+
+void Display::measureText(TextMetrics &metrics, const uint8_t *font,
+                          const char *text, TextLayout *layout) {
+  metrics = TextMetrics();
+  if (layout) {
+    layout->numGlyphs = 0;
+    layout->overflow = nullptr;
+  }
 
   uint16_t maxAscent = 0, maxDescent = 0;
 
-  Font::Font fontObject = Font::Font(font);
+  Font::Font fontObject(font);
 
   // if the first character has a negative BBX X Offset we need to add it to the
   // width
   bool firstCharacter = true;
 
   uint16_t currentCharCode;
-  Font::Character currentChar = Font::Character();
+  TextLayout::Glyph currentGlyph = {};
 
+  const char *currentText = text;
   while ((currentCharCode = readUTF8Char(text))) {
-    currentChar = fontObject.getCharacter(currentCharCode);
+    currentGlyph = toGlyph(fontObject.getCharacter(currentCharCode));
+
+    if (layout && layout->numGlyphs < TEXT_LAYOUT_CAPACITY) {
+      layout->glyphs[layout->numGlyphs++] = currentGlyph;
+    } else if (layout && !layout->overflow) {
+      layout->overflow = currentText;
+    }
+    currentText = text;
 
-    width += currentChar.deviceWidthX;
-    baselineLength += currentChar.deviceWidthX;
+    metrics.width += currentGlyph.deviceWidthX;
+    metrics.baselineLength += currentGlyph.deviceWidthX;
 
     // Starting to the left or right of the origin needs to be factored in for
     // first character. Middle characters are just measured by the device width.
     if (firstCharacter) {
       firstCharacter = false;
 
-      width -= currentChar.bbxXOffset;
-      originXOffset = -1 * currentChar.bbxXOffset;
+      metrics.width -= currentGlyph.bbxXOffset;
+      metrics.originXOffset = -1 * currentGlyph.bbxXOffset;
     }
 
-    uint16_t ascent = currentChar.bbxHeight + currentChar.bbxYOffset;
+    uint16_t ascent = currentGlyph.bbxHeight + currentGlyph.bbxYOffset;
     maxAscent = ascent > maxAscent ? ascent : maxAscent;
 
     uint16_t descent =
-      currentChar.bbxYOffset < 0 ? -1 * currentChar.bbxYOffset : 0;
+      currentGlyph.bbxYOffset < 0 ? -1 * currentGlyph.bbxYOffset : 0;
     maxDescent = descent > maxDescent ? descent : maxDescent;
 
-    height = maxAscent + maxDescent;
+    metrics.height = maxAscent + maxDescent;
   }
 
   // the device width often extends beyond the BBX, so for the last char we need
   // to calculate the added width based on the BBX instead
-  width -= currentChar.deviceWidthX;                       // undo the last operation
-  width += currentChar.bbxWidth + currentChar.bbxXOffset;  // add width and account for offset
+  metrics.width -= currentGlyph.deviceWidthX;                        // undo the last operation
+  metrics.width += currentGlyph.bbxWidth + currentGlyph.bbxXOffset;  // add width and account for offset
 
-  originYOffset = maxAscent - 1;
+  metrics.originYOffset = maxAscent - 1;
 };
 
-void Display::setFont(uint8_t *font) {
-  defaultFont = font;
-}
-
+// Measuring and then drawing a plain string looks every glyph up twice, which
+// is cheap with the glyph index and keeps a `TextLayout` off the stack.
 void Display::getTextSize(const char *text, uint16_t &width, uint16_t &height,
                           TextOptions options) {
-  if (options.getFont() == nullptr) {
-    options = options.font(defaultFont);
-  }
+  TextMetrics metrics;
+  measureText(metrics, options.getFont() ? options.getFont() : defaultFont, text);
 
-  int16_t originXOffset, originYOffset;
-  uint16_t baselineLength;
-  getTextSize(options.getFont(), text, width, height, originXOffset,
-              originYOffset, baselineLength);
+  width = metrics.width;
+  height = metrics.height;
 };
 
 void Display::drawText(int16_t x, int16_t y, const char *text,
                        TextOptions options) {
-  if (options.getFont() == nullptr) {
-    options = options.font(defaultFont);
-  }
+  const uint8_t *font = options.getFont() ? options.getFont() : defaultFont;
+
+  TextMetrics metrics;
+  measureText(metrics, font, text);
+  drawMeasuredText(x, y, metrics, font, nullptr, 0, text, options);
+};
+
+void Display::drawGlyph(int16_t x, int16_t y, const TextLayout::Glyph &glyph,
+                        uint16_t color) {
+  // glyphs are positioned by their bottom left corner, goes straight to the
+  // driver so glyphs don't show up as separate bitmaps in the profiler
+  driver->writeBitmapToBuffer(x + glyph.bbxXOffset,
+                              y - glyph.bbxYOffset - (glyph.bbxHeight - 1),
+                              glyph.bbxWidth,
+                              glyph.bbxHeight, glyph.bitmap,
+                              BitmapOptions()
+                                .negative(true)  // serialized format is 1==black, 0==white,
+                                                 // but we need to flip that
+                                .color(color));
+}
+
+void Display::drawText(int16_t x, int16_t y, TextLayout &layout,
+                       TextOptions options) {
+  drawMeasuredText(x, y, layout.metrics, layout.font, layout.glyphs,
+                   layout.numGlyphs, layout.overflow, options);
+};
 
-  Font::Font fontObject(options.getFont());
+void Display::drawMeasuredText(int16_t x, int16_t y, const TextMetrics &metrics,
+                               const uint8_t *font,
+                               const TextLayout::Glyph *glyphs,
+                               uint8_t numGlyphs, const char *rest,
+                               TextOptions options) {
+  PROFILE_SCOPE(::Profiler::RECORD_DRAW, ::Profiler::DRAW_TEXT);
 
-  uint16_t width = 0, height = 0, baselineLength = 0;
-  int16_t originXOffset = 0, originYOffset = 0;
-  getTextSize(options.getFont(), text, width, height, originXOffset,
-              originYOffset, baselineLength);
+  uint16_t width = metrics.width, height = metrics.height,
+           baselineLength = metrics.baselineLength;
+  int16_t originXOffset = metrics.originXOffset,
+          originYOffset = metrics.originYOffset;
 
   int16_t originX = x, originY = y;
 
@@ -213,27 +428,28 @@ void Display::drawText(int16_t x, int16_t y, const char *text,
   // overridden, to simulate non-transparent text we instead draw a
   // rectangle over the area the text covers
   if (options.getOpaque()) {
-    fillRectangle(originX - originXOffset, originY - originYOffset, width,
-                  height,
-                  Object2DOptions().color(options.getColor() ? 0x00 : 0xff));
+    driver->setBufferBlock(originX - originXOffset, originY - originYOffset,
+                           width, height, options.getColor() ? 0x00 : 0xff);
   }
 
-  uint16_t currentCharCode;
-  Font::Character currentChar = Font::Character();
+  for (uint8_t i = 0; i < numGlyphs; i++) {
+    drawGlyph(originX, originY, glyphs[i], options.getColor());
+    originX += glyphs[i].deviceWidthX;
+  }
 
-  while ((currentCharCode = readUTF8Char(text))) {
-    currentChar = fontObject.getCharacter(currentCharCode);
-    drawBitmap(originX + currentChar.bbxXOffset,
-               originY - currentChar.bbxYOffset,
-               currentChar.bbxWidth,
-               currentChar.bbxHeight, currentChar.bitmap,
-               BitmapOptions()
-                 .negative(true)  // serialized format is 1==black, 0==white,
-                                  // but we need to flip that
-                 .color(options.getColor())
-                 .origin(Origin::Object2D::BOTTOM_LEFT));
-
-    originX += currentChar.deviceWidthX;
+  if (!rest) {
+    return;
+  }
+
+  // the rest of a string too long for the layout, or all of a plain string, is
+  // looked up again
+  Font::Font fontObject(font);
+
+  uint16_t currentCharCode;
+  while ((currentCharCode = readUTF8Char(rest))) {
+    TextLayout::Glyph glyph = toGlyph(fontObject.getCharacter(currentCharCode));
+    drawGlyph(originX, originY, glyph, options.getColor());
+    originX += glyph.deviceWidthX;
   }
 };
 
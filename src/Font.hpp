@@ -44,6 +44,12 @@ namespace Display::Font {
 #define CHARACTER_BBX_Y_OFFSET_TYPE int8_t
 #define CHARACTER_BITMAP 10
 
+// glyph index sizing, see `GlyphIndex`
+#define FONT_INDEX_CACHE_SIZE 2
+#define FONT_INDEX_ASCII_FIRST 0x20
+#define FONT_INDEX_ASCII_LAST 0x7e
+#define FONT_INDEX_CHECKPOINTS 48
+
 class Character {
 public:
   CHARACTER_CODE_TYPE code = 0;
@@ -55,12 +61,30 @@ public:
   CHARACTER_BBX_X_OFFSET_TYPE bbxXOffset = 0;
   CHARACTER_BBX_Y_OFFSET_TYPE bbxYOffset = 0;
 
-  uint8_t *bitmap = nullptr;
+  const uint8_t *bitmap = nullptr;
 
-  Character(uint8_t *character);
+  Character(const uint8_t *character);
   Character() {}
 };
 
+// Lookup table for the glyphs of one font, built the first time the font is
+// used. Printable ASCII glyphs are found directly, everything else is found by
+// binary searching every Nth glyph (a checkpoint) and then walking at most N
+// glyphs. Offsets are relative to the font's first character. The cache of
+// indexes is shared by every thread, see Font.cpp.
+struct GlyphIndex {
+  const uint8_t *font = nullptr;
+  uint32_t lastUsed = 0;
+  uint8_t users = 0;  // `Font`s pinning it, only rebuilt once there are none
+
+  uint16_t ascii[FONT_INDEX_ASCII_LAST - FONT_INDEX_ASCII_FIRST + 1];  // 0 if missing
+
+  uint16_t checkpointCodes[FONT_INDEX_CHECKPOINTS];
+  uint16_t checkpointOffsets[FONT_INDEX_CHECKPOINTS];
+  uint8_t numCheckpoints = 0;
+  uint16_t checkpointStride = 1;
+};
+
 class Font {
 public:
   FONT_SIZE_TYPE size;
@@ -72,11 +96,26 @@ public:
   FONT_ASCENT_TYPE ascent;
   FONT_DESCENT_TYPE descent;
 
-  uint8_t *firstCharacter;
+  const uint8_t *firstCharacter;
 
-  Font(uint8_t *font);
+  // pins the font's glyph index until destroyed, so only keep fonts around
+  // while drawing or measuring
+  Font(const uint8_t *font);
+  ~Font();
+  Font(const Font &) = delete;
+  Font &operator=(const Font &) = delete;
 
   Character getCharacter(uint16_t character);
+
+private:
+  const uint8_t *font;
+  GlyphIndex *index;  // nullptr if every cached index was pinned by other fonts
+
+  // returns the offset of `character` from the first character, 0 (the
+  // missing character replacement glyph) if the font doesn't have it
+  uint16_t findCharacter(uint16_t character);
+  uint16_t searchIndex(const GlyphIndex &glyphIndex, uint16_t character);
+  uint16_t walkCharacters(uint16_t character);
 };
 
 }  // namespace Display::Font
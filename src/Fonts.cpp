@@ -10,7 +10,7 @@ namespace Display::Font {
 //   - Copyright (c) 2019 Yomli  Copyright (c) 1850 Bailleul et Cie  Copyright (c) 1800 Justus Erich Walbaum"
 //   - Size: 8
 //   - Characters: 232
-uint8_t bailleul_8_pt[3698] = "\x08\x00\xe8\x0e\x0f\xfe\xfd\x0a\x02\x00\x00\x00\x0e\x05\x08\x04\x08\x00\x00\xf9"
+const uint8_t bailleul_8_pt[3698] = "\x08\x00\xe8\x0e\x0f\xfe\xfd\x0a\x02\x00\x00\x00\x0e\x05\x08\x04\x08\x00\x00\xf9"
                               "\x99\x99\x9f\x00\x20\x00\x0a\x03\x00\x00\x00\x00\x00\x00\x21\x00\x0c\x03\x00\x01"
                               "\x09\x01\x00\xff\x80\x00\x22\x00\x0c\x05\x00\x03\x04\x01\x05\xb6\xd0\x00\x23\x00"
                               "\x10\x06\x00\x06\x08\x00\x00\x28\xa7\xca\x4b\xe5\x14\x00\x24\x00\x11\x06\x00\x05"
@@ -200,7 +200,7 @@ uint8_t bailleul_8_pt[3698] = "\x08\x00\xe8\x0e\x0f\xfe\xfd\x0a\x02\x00\x00\x00\
 //   - Copyright (c) 2019 Yomli  Copyright (c) 1850 Bailleul et Cie  Copyright (c) 1800 Justus Erich Walbaum"
 //   - Size: 12
 //   - Characters: 232
-uint8_t bailleul_12_pt[5324] = "\x0c\x00\xe8\x15\x16\xfd\xfb\x10\x04\x00\x00\x00\x13\x07\x0c\x06\x0c\x00\x00\xfe"
+const uint8_t bailleul_12_pt[5324] = "\x0c\x00\xe8\x15\x16\xfd\xfb\x10\x04\x00\x00\x00\x13\x07\x0c\x06\x0c\x00\x00\xfe"
                                "\x18\x61\x86\x18\x61\x86\x18\x7f\x00\x20\x00\x0a\x05\x00\x00\x00\x00\x00\x00\x21"
                                "\x00\x0f\x05\x00\x03\x0d\x01\x00\x5f\xa4\x92\x40\x74\x00\x22\x00\x0d\x08\x00\x04"
                                "\x06\x02\x07\x9b\x99\x99\x00\x23\x00\x19\x09\x00\x09\x0d\x00\x00\x11\x09\x04\x82"
@@ -472,7 +472,7 @@ uint8_t bailleul_12_pt[5324] = "\x0c\x00\xe8\x15\x16\xfd\xfb\x10\x04\x00\x00\x00
 //   - Copyright (c) 2019 Yomli  Copyright (c) 1850 Bailleul et Cie  Copyright (c) 1800 Justus Erich Walbaum"
 //   - Size: 16
 //   - Characters: 232
-uint8_t bailleul_16_pt[7002] = "\x10\x00\xe8\x1b\x1b\xfc\xfa\x14\x05\x00\x00\x00\x1a\x09\x10\x08\x10\x00\x00\xff"
+const uint8_t bailleul_16_pt[7002] = "\x10\x00\xe8\x1b\x1b\xfc\xfa\x14\x05\x00\x00\x00\x1a\x09\x10\x08\x10\x00\x00\xff"
                                "\x81\x81\x81\x81\x81\x81\x81\x81\x81\x81\x81\x81\x81\x81\xff\x00\x20\x00\x0a\x06"
                                "\x00\x00\x00\x00\x00\x00\x21\x00\x10\x07\x00\x03\x10\x02\x00\xdf\xfd\xb6\x49\x21"
                                "\xbe\x00\x22\x00\x10\x0a\x00\x06\x07\x02\x09\x4f\x34\xd3\x49\x24\x80\x00\x23\x00"
@@ -828,7 +828,7 @@ uint8_t bailleul_16_pt[7002] = "\x10\x00\xe8\x1b\x1b\xfc\xfa\x14\x05\x00\x00\x00
 //   - Copyright (c) 2019 Yomli  Copyright (c) 1850 Bailleul et Cie  Copyright (c) 1800 Justus Erich Walbaum"
 //   - Size: 8
 //   - Characters: 232
-uint8_t bailleul_bold_8_pt[3850] = "\x08\x00\xe8\x0e\x0e\xfe\xfd\x0a\x02\x00\x00\x00\x0e\x05\x08\x04\x08\x00\x00\xf9"
+const uint8_t bailleul_bold_8_pt[3850] = "\x08\x00\xe8\x0e\x0e\xfe\xfd\x0a\x02\x00\x00\x00\x0e\x05\x08\x04\x08\x00\x00\xf9"
                                    "\x99\x99\x9f\x00\x20\x00\x0a\x03\x00\x00\x00\x00\x00\x00\x21\x00\x0d\x03\x00\x02"
                                    "\x09\x01\x00\xaa\xa2\xc0\x00\x22\x00\x0c\x05\x00\x03\x04\x01\x05\xb6\xd0\x00\x23"
                                    "\x00\x11\x06\x00\x06\x09\x00\x00\x28\xa2\x9f\x29\x2f\x94\x50\x00\x24\x00\x13\x06"
@@ -1026,7 +1026,7 @@ uint8_t bailleul_bold_8_pt[3850] = "\x08\x00\xe8\x0e\x0e\xfe\xfd\x0a\x02\x00\x00
 //   - Copyright (c) 2019 Yomli  Copyright (c) 1850 Bailleul et Cie  Copyright (c) 1800 Justus Erich Walbaum"
 //   - Size: 12
 //   - Characters: 232
-uint8_t bailleul_bold_12_pt[5584] = "\x0c\x00\xe8\x16\x16\xfd\xfc\x10\x04\x00\x00\x00\x13\x07\x0c\x06\x0c\x00\x00\xfe"
+const uint8_t bailleul_bold_12_pt[5584] = "\x0c\x00\xe8\x16\x16\xfd\xfc\x10\x04\x00\x00\x00\x13\x07\x0c\x06\x0c\x00\x00\xfe"
                                     "\x18\x61\x86\x18\x61\x86\x18\x7f\x00\x20\x00\x0a\x05\x00\x00\x00\x00\x00\x00\x21"
                                     "\x00\x0f\x05\x00\x03\x0d\x01\x00\x7f\xf4\x92\x41\x7e\x00\x22\x00\x0e\x08\x00\x05"
                                     "\x06\x02\x07\x94\xe5\x29\x48\x00\x23\x00\x19\x09\x00\x09\x0d\x00\x00\x1b\x09\x84"
@@ -1311,7 +1311,7 @@ uint8_t bailleul_bold_12_pt[5584] = "\x0c\x00\xe8\x16\x16\xfd\xfc\x10\x04\x00\x0
 //   - Copyright (c) 2019 Yomli  Copyright (c) 1850 Bailleul et Cie  Copyright (c) 1800 Justus Erich Walbaum"
 //   - Size: 16
 //   - Characters: 232
-uint8_t bailleul_bold_16_pt[7418] = "\x10\x00\xe8\x1d\x1b\xfc\xfa\x15\x05\x00\x00\x00\x1a\x09\x10\x08\x10\x00\x00\xff"
+const uint8_t bailleul_bold_16_pt[7418] = "\x10\x00\xe8\x1d\x1b\xfc\xfa\x15\x05\x00\x00\x00\x1a\x09\x10\x08\x10\x00\x00\xff"
                                     "\x81\x81\x81\x81\x81\x81\x81\x81\x81\x81\x81\x81\x81\x81\xff\x00\x20\x00\x0a\x06"
                                     "\x00\x00\x00\x00\x00\x00\x21\x00\x12\x07\x00\x04\x10\x01\x00\x67\x77\x76\x66\x62"
                                     "\x22\x07\xf7\x00\x22\x00\x10\x0b\x00\x06\x07\x02\x09\xcf\x3c\xf3\xcd\x14\x40\x00"
@@ -1687,7 +1687,7 @@ uint8_t bailleul_bold_16_pt[7418] = "\x10\x00\xe8\x1d\x1b\xfc\xfa\x15\x05\x00\x0
 //   - (C) 2023 Intel Corporation"
 //   - Size: 8
 //   - Characters: 622
-uint8_t intel_one_mono_8_pt[9558] = "\x08\x02\x6e\x0a\x10\xfe\xfc\x0b\x03\x00\x00\x00\x0e\x05\x08\x04\x08\x00\x00\xf9"
+const uint8_t intel_one_mono_8_pt[9558] = "\x08\x02\x6e\x0a\x10\xfe\xfc\x0b\x03\x00\x00\x00\x0e\x05\x08\x04\x08\x00\x00\xf9"
                                     "\x99\x99\x9f\x00\x20\x00\x0a\x07\x00\x00\x00\x00\x00\x00\x21\x00\x0c\x07\x00\x02"
                                     "\x08\x02\x00\x55\x43\x00\x22\x00\x0c\x07\x00\x04\x03\x01\x05\xdd\x50\x00\x23\x00"
                                     "\x10\x07\x00\x06\x07\x00\x00\x24\xa7\xca\xfd\x45\x00\x00\x24\x00\x11\x07\x00\x05"
@@ -2170,7 +2170,7 @@ uint8_t intel_one_mono_8_pt[9558] = "\x08\x02\x6e\x0a\x10\xfe\xfc\x0b\x03\x00\x0
 //   - (C) 2023 Intel Corporation"
 //   - Size: 12
 //   - Characters: 622
-uint8_t intel_one_mono_12_pt[13771] = "\x0c\x02\x6e\x0f\x18\xfd\xfb\x12\x04\x00\x00\x00\x13\x07\x0c\x06\x0c\x00\x00\xfe"
+const uint8_t intel_one_mono_12_pt[13771] = "\x0c\x02\x6e\x0f\x18\xfd\xfb\x12\x04\x00\x00\x00\x13\x07\x0c\x06\x0c\x00\x00\xfe"
                                       "\x18\x61\x86\x18\x61\x86\x18\x7f\x00\x20\x00\x0a\x0a\x00\x00\x00\x00\x00\x00\x21"
                                       "\x00\x0f\x0a\x00\x03\x0c\x04\x00\xfb\x6d\x92\x03\x60\x00\x22\x00\x0e\x0a\x00\x06"
                                       "\x05\x02\x07\xcf\x1c\x71\xc4\x00\x23\x00\x17\x0a\x00\x09\x0b\x01\x00\x12\x09\x04"
@@ -2864,7 +2864,7 @@ uint8_t intel_one_mono_12_pt[13771] = "\x0c\x02\x6e\x0f\x18\xfd\xfb\x12\x04\x00\
 //   - (C) 2023 Intel Corporation"
 //   - Size: 16
 //   - Characters: 622
-uint8_t intel_one_mono_16_pt[19232] = "\x10\x02\x6e\x14\x20\xfc\xf9\x17\x06\x00\x00\x00\x1a\x09\x10\x08\x10\x00\x00\xff"
+const uint8_t intel_one_mono_16_pt[19232] = "\x10\x02\x6e\x14\x20\xfc\xf9\x17\x06\x00\x00\x00\x1a\x09\x10\x08\x10\x00\x00\xff"
                                       "\x81\x81\x81\x81\x81\x81\x81\x81\x81\x81\x81\x81\x81\x81\xff\x00\x20\x00\x0a\x0e"
                                       "\x00\x00\x00\x00\x00\x00\x21\x00\x12\x0e\x00\x04\x10\x05\x00\xfe\xee\xe6\x66\x64"
                                       "\x00\x0e\xee\x00\x22\x00\x11\x0e\x00\x08\x07\x03\x09\xc7\xc7\xc7\xc3\xc3\xc3\xc3"
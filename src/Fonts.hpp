@@ -13,55 +13,55 @@ namespace Display::Font {
 //   - Copyright (c) 2019 Yomli  Copyright (c) 1850 Bailleul et Cie  Copyright (c) 1800 Justus Erich Walbaum"
 //   - Size: 8
 //   - Characters: 232
-extern uint8_t bailleul_8_pt[3698];
+extern const uint8_t bailleul_8_pt[3698];
 
 // bailleul
 //   - Copyright (c) 2019 Yomli  Copyright (c) 1850 Bailleul et Cie  Copyright (c) 1800 Justus Erich Walbaum"
 //   - Size: 12
 //   - Characters: 232
-extern uint8_t bailleul_12_pt[5324];
+extern const uint8_t bailleul_12_pt[5324];
 
 // bailleul
 //   - Copyright (c) 2019 Yomli  Copyright (c) 1850 Bailleul et Cie  Copyright (c) 1800 Justus Erich Walbaum"
 //   - Size: 16
 //   - Characters: 232
-extern uint8_t bailleul_16_pt[7002];
+extern const uint8_t bailleul_16_pt[7002];
 
 // bailleul_bold
 //   - Copyright (c) 2019 Yomli  Copyright (c) 1850 Bailleul et Cie  Copyright (c) 1800 Justus Erich Walbaum"
 //   - Size: 8
 //   - Characters: 232
-extern uint8_t bailleul_bold_8_pt[3850];
+extern const uint8_t bailleul_bold_8_pt[3850];
 
 // bailleul_bold
 //   - Copyright (c) 2019 Yomli  Copyright (c) 1850 Bailleul et Cie  Copyright (c) 1800 Justus Erich Walbaum"
 //   - Size: 12
 //   - Characters: 232
-extern uint8_t bailleul_bold_12_pt[5584];
+extern const uint8_t bailleul_bold_12_pt[5584];
 
 // bailleul_bold
 //   - Copyright (c) 2019 Yomli  Copyright (c) 1850 Bailleul et Cie  Copyright (c) 1800 Justus Erich Walbaum"
 //   - Size: 16
 //   - Characters: 232
-extern uint8_t bailleul_bold_16_pt[7418];
+extern const uint8_t bailleul_bold_16_pt[7418];
 
 // intel_one_mono
 //   - (C) 2023 Intel Corporation"
 //   - Size: 8
 //   - Characters: 622
-extern uint8_t intel_one_mono_8_pt[9558];
+extern const uint8_t intel_one_mono_8_pt[9558];
 
 // intel_one_mono
 //   - (C) 2023 Intel Corporation"
 //   - Size: 12
 //   - Characters: 622
-extern uint8_t intel_one_mono_12_pt[13771];
+extern const uint8_t intel_one_mono_12_pt[13771];
 
 // intel_one_mono
 //   - (C) 2023 Intel Corporation"
 //   - Size: 16
 //   - Characters: 622
-extern uint8_t intel_one_mono_16_pt[19232];
+extern const uint8_t intel_one_mono_16_pt[19232];
 
 }  // namespace Display::Font
 
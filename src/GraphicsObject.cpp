@@ -7,6 +7,7 @@
 void GraphicsObject::setPosition(int16_t x, int16_t y) {
   this->x = x;
   this->y = y;
+  dirty = true;
 
   if (!this->isVisible()) {
     lastRenderedX = x;
@@ -40,5 +41,13 @@ bool GraphicsObject::isVisible() {
 }
 void GraphicsObject::setVisible(bool visible) {
   this->visible = visible;
+  dirty = true;
   onSetVisible();
+}
+
+void GraphicsObject::getBounds(int16_t &x, int16_t &y, uint16_t &width,
+                               uint16_t &height) {
+  x = 0;
+  y = 0;
+  width = height = KYWY_DISPLAY_WIDTH > KYWY_DISPLAY_HEIGHT ? KYWY_DISPLAY_WIDTH : KYWY_DISPLAY_HEIGHT;  // either rotation
 }
\ No newline at end of file
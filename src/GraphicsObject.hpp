@@ -7,8 +7,12 @@
 
 #include "Display.hpp"
 
+class Compositor;
+
 class GraphicsObject {
 public:
+  // erases the object where it was last rendered and draws it where it is now,
+  // objects added to a `Compositor` are drawn by it instead
   void render();
   void setDisplay(Display::Display *display);
   void setPosition(int16_t x, int16_t y);
@@ -30,8 +34,21 @@ public:
   virtual void draw() = 0;
   virtual void erase(int16_t lastRenderedX, int16_t lastRenderedY) = 0;
 
+  // the rectangle `draw` covers, the whole screen unless the object knows
+  // better
+  virtual void getBounds(int16_t &x, int16_t &y, uint16_t &width, uint16_t &height);
+
+  // tells a `Compositor` the object looks different even though it hasn't
+  // moved, e.g. after changing frame
+  void markDirty() {
+    dirty = true;
+  };
+
 private:
+  friend class Compositor;
+
   bool visible = false;
+  bool dirty = true;
 
   bool lastRenderedVisible = false;
   int16_t lastRenderedX = 0;
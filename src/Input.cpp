@@ -5,141 +5,350 @@
 #include "Input.hpp"
 #include "Events.hpp"
 
+#if defined(TARGET_RP2040)
+#include "hardware/gpio.h"
+#endif
+
 namespace Kywy {
 
-void Input::initialize() {
-  pinMode(KYWY_LEFT_BUTTON, INPUT_PULLUP);
-  pinMode(KYWY_RIGHT_BUTTON, INPUT_PULLUP);
-  pinMode(KYWY_D_PAD_UP, INPUT_PULLUP);
-  pinMode(KYWY_D_PAD_DOWN, INPUT_PULLUP);
-  pinMode(KYWY_D_PAD_LEFT, INPUT_PULLUP);
-  pinMode(KYWY_D_PAD_RIGHT, INPUT_PULLUP);
-  pinMode(KYWY_D_PAD_CENTER, INPUT_PULLUP);
-
-  inputMessage.signal = Events::KywyEvents::INPUT;
-  inputPressedMessage.signal = Events::KywyEvents::INPUT_PRESSED;
-  dPadMessage.signal = Events::KywyEvents::D_PAD;
-  dPadPressedMessage.signal = Events::KywyEvents::D_PAD_PRESSED;
-
-  buttonLeftPressedMessage.signal = Events::KywyEvents::BUTTON_LEFT_PRESSED;
-  buttonLeftReleasedMessage.signal = Events::KywyEvents::BUTTON_LEFT_RELEASED;
-  buttonRightPressedMessage.signal = Events::KywyEvents::BUTTON_RIGHT_PRESSED;
-  buttonRightReleasedMessage.signal = Events::KywyEvents::BUTTON_RIGHT_RELEASED;
-  dPadLeftPressedMessage.signal = Events::KywyEvents::D_PAD_LEFT_PRESSED;
-  dPadLeftReleasedMessage.signal = Events::KywyEvents::D_PAD_LEFT_RELEASED;
-  dPadRightPressedMessage.signal = Events::KywyEvents::D_PAD_RIGHT_PRESSED;
-  dPadRightReleasedMessage.signal = Events::KywyEvents::D_PAD_RIGHT_RELEASED;
-  dPadUpPressedMessage.signal = Events::KywyEvents::D_PAD_UP_PRESSED;
-  dPadUpReleasedMessage.signal = Events::KywyEvents::D_PAD_UP_RELEASED;
-  dPadDownPressedMessage.signal = Events::KywyEvents::D_PAD_DOWN_PRESSED;
-  dPadDownReleasedMessage.signal = Events::KywyEvents::D_PAD_DOWN_RELEASED;
-  dPadCenterPressedMessage.signal = Events::KywyEvents::D_PAD_CENTER_PRESSED;
-  dPadCenterReleasedMessage.signal = Events::KywyEvents::D_PAD_CENTER_RELEASED;
+// indexed by `Button`
+static const uint8_t buttonPins[BUTTON_COUNT] = {
+  KYWY_LEFT_BUTTON,
+  KYWY_RIGHT_BUTTON,
+  KYWY_D_PAD_LEFT,
+  KYWY_D_PAD_RIGHT,
+  KYWY_D_PAD_UP,
+  KYWY_D_PAD_DOWN,
+  KYWY_D_PAD_CENTER,
+};
+static const int pressedSignals[BUTTON_COUNT] = {
+  Events::BUTTON_LEFT_PRESSED,
+  Events::BUTTON_RIGHT_PRESSED,
+  Events::D_PAD_LEFT_PRESSED,
+  Events::D_PAD_RIGHT_PRESSED,
+  Events::D_PAD_UP_PRESSED,
+  Events::D_PAD_DOWN_PRESSED,
+  Events::D_PAD_CENTER_PRESSED,
+};
+static const int releasedSignals[BUTTON_COUNT] = {
+  Events::BUTTON_LEFT_RELEASED,
+  Events::BUTTON_RIGHT_RELEASED,
+  Events::D_PAD_LEFT_RELEASED,
+  Events::D_PAD_RIGHT_RELEASED,
+  Events::D_PAD_UP_RELEASED,
+  Events::D_PAD_DOWN_RELEASED,
+  Events::D_PAD_CENTER_RELEASED,
+};
+
+// attachInterrupt callbacks don't take an argument
+static Input *interruptInput = nullptr;
+
+void inputInterruptCallback() {
+  Input *input = interruptInput;
+  if (input->replayLog) {
+    return;  // the log drives the buttons
+  }
+
+  uint8_t edgesTail = input->edgesTail;
+
+  // the interrupt fires as the pin changes
+  uint32_t time = micros();
+  input->capture(input->readButtons(), time, time);
+
+  if (input->edgesTail != edgesTail) {
+    // coalesces, so a burst of edges wakes the actor once
+    ::Actor::Message wake(Events::INPUT_CAPTURED, nullptr, ::Actor::PRIORITY_HIGH);
+    wake.coalesce = true;
+    input->dispatch(wake);
+  }
 }
 
-void Input::handle(::Actor::Message *message) {
-  switch (message->signal) {
-    case Events::TICK:
-      {
-        bool inputEvent = false, dPadEvent = false;
-        bool inputPressedEvent = false, dPadPressedEvent = false;
-
-        if ((digitalRead(KYWY_LEFT_BUTTON) == LOW) != _buttonLeftPressed) {
-          _buttonLeftPressed = !_buttonLeftPressed;
-          buttonLeftPressed = _buttonLeftPressed;
-          publish(_buttonLeftPressed ? &buttonLeftPressedMessage : &buttonLeftReleasedMessage);
-          inputEvent = true;
-          if (_buttonLeftPressed) {
-            inputPressedEvent = true;
-          }
-        }
+// buttons are active low, returns a bit per `Button` that is held
+uint8_t Input::readButtons() {
+  uint8_t buttons = 0;
 
-        if ((digitalRead(KYWY_RIGHT_BUTTON) == LOW) != _buttonRightPressed) {
-          _buttonRightPressed = !_buttonRightPressed;
-          buttonRightPressed = _buttonRightPressed;
-          publish(_buttonRightPressed ? &buttonRightPressedMessage : &buttonRightReleasedMessage);
-          inputEvent = true;
-          if (_buttonRightPressed) {
-            inputPressedEvent = true;
-          }
-        }
+#if defined(TARGET_RP2040)
+  // every pin in one read, Arduino pin numbers are GPIO numbers on the Pico
+  uint32_t pins = gpio_get_all();
+  for (uint8_t i = 0; i < BUTTON_COUNT; i++) {
+    if (!(pins & (1u << buttonPins[i]))) {
+      buttons |= 1 << i;
+    }
+  }
+#else
+  for (uint8_t i = 0; i < BUTTON_COUNT; i++) {
+    if (digitalRead(buttonPins[i]) == LOW) {
+      buttons |= 1 << i;
+    }
+  }
+#endif
 
-        if ((digitalRead(KYWY_D_PAD_LEFT) == LOW) != _dPadLeftPressed) {
-          _dPadLeftPressed = !_dPadLeftPressed;
-          dPadLeftPressed = _dPadLeftPressed;
-          publish(_dPadLeftPressed ? &dPadLeftPressedMessage : &dPadLeftReleasedMessage);
-          inputEvent = true;
-          dPadEvent = true;
-          if (_dPadLeftPressed) {
-            inputPressedEvent = true;
-            dPadPressedEvent = true;
-          }
-        }
+  return buttons;
+}
 
-        if ((digitalRead(KYWY_D_PAD_RIGHT) == LOW) != _dPadRightPressed) {
-          _dPadRightPressed = !_dPadRightPressed;
-          dPadRightPressed = _dPadRightPressed;
-          publish(_dPadRightPressed ? &dPadRightPressedMessage : &dPadRightReleasedMessage);
-          inputEvent = true;
-          dPadEvent = true;
-          if (_dPadRightPressed) {
-            inputPressedEvent = true;
-            dPadPressedEvent = true;
-          }
-        }
+// has to be called with interrupts disabled or from the interrupt, changes
+// happened after `since`
+void Input::capture(uint8_t buttons, uint32_t time, uint32_t since) {
+  lastReadAt = time;
 
-        if ((digitalRead(KYWY_D_PAD_UP) == LOW) != _dPadUpPressed) {
-          _dPadUpPressed = !_dPadUpPressed;
-          dPadUpPressed = _dPadUpPressed;
-          publish(_dPadUpPressed ? &dPadUpPressedMessage : &dPadUpReleasedMessage);
-          inputEvent = true;
-          dPadEvent = true;
-          if (_dPadUpPressed) {
-            inputPressedEvent = true;
-            dPadPressedEvent = true;
-          }
-        }
+  uint8_t changed = buttons ^ captured;
+  uint32_t debounce = options.getDebounce() * 1000;
 
-        if ((digitalRead(KYWY_D_PAD_DOWN) == LOW) != _dPadDownPressed) {
-          _dPadDownPressed = !_dPadDownPressed;
-          dPadDownPressed = _dPadDownPressed;
-          publish(_dPadDownPressed ? &dPadDownPressedMessage : &dPadDownReleasedMessage);
-          inputEvent = true;
-          dPadEvent = true;
-          if (_dPadDownPressed) {
-            inputPressedEvent = true;
-            dPadPressedEvent = true;
-          }
-        }
+  for (uint8_t i = 0; i < BUTTON_COUNT; i++) {
+    if (!(changed & (1 << i))) {
+      continue;
+    }
 
-        if ((digitalRead(KYWY_D_PAD_CENTER) == LOW) != _dPadCenterPressed) {
-          _dPadCenterPressed = !_dPadCenterPressed;
-          dPadCenterPressed = _dPadCenterPressed;
-          publish(_dPadCenterPressed ? &dPadCenterPressedMessage : &dPadCenterReleasedMessage);
-          inputEvent = true;
-          dPadEvent = true;
-          if (_dPadCenterPressed) {
-            inputPressedEvent = true;
-            dPadPressedEvent = true;
-          }
-        }
+    // a button that keeps changing is bouncing, whatever it settles on is
+    // picked up by a later capture
+    if (time - lastEdgeAt[i] < debounce) {
+      stats.bounces++;
+      continue;
+    }
 
-        if (inputEvent) {
-          publish(&inputMessage);
-        }
+    captured ^= 1 << i;
+    lastEdgeAt[i] = time;
+    pushEdge((Button)i, captured & (1 << i), time, since);
+  }
+}
 
-        if (inputPressedEvent) {
-          publish(&inputPressedMessage);
-        }
+// has to be called with interrupts disabled or from the interrupt
+void Input::pushEdge(Button button, bool pressed, uint32_t time, uint32_t since) {
+  uint8_t tail = edgesTail;
+  if ((uint8_t)(tail - edgesHead) == INPUT_EDGE_QUEUE_SIZE) {
+    stats.dropped++;
+    return;  // full
+  }
+
+  edges[tail % INPUT_EDGE_QUEUE_SIZE] = { time, since, button, pressed };
+  edgesTail = tail + 1;
+}
+
+void Input::inject(Button button, bool pressed, uint32_t time) {
+  if (button >= BUTTON_COUNT) {
+    // TODO: error
+    return;
+  }
+
+  core_util_critical_section_enter();
+  if (((captured >> button) & 1) != pressed) {
+    captured ^= 1 << button;
+    lastEdgeAt[button] = time;
+    pushEdge(button, pressed, time, time);
+  }
+  core_util_critical_section_exit();
+
+  ::Actor::Message wake(Events::INPUT_CAPTURED, nullptr, ::Actor::PRIORITY_HIGH);
+  wake.coalesce = true;
+  dispatch(wake);
+}
+
+void Input::startRecording(uint8_t *buffer, uint16_t size) {
+  recordingSize = size;
+  recordingLength = 0;
+  recording = buffer;
+}
+
+uint16_t Input::stopRecording() {
+  recording = nullptr;
+  return recordingLength;
+}
+
+void Input::recordTick() {
+  // pressed and released within the tick, in either order
+  uint8_t taps = pressed & released;
+
+  if (recordingLength) {
+    uint8_t *last = recording + recordingLength - INPUT_LOG_ENTRY_SIZE;
+    if (last[0] == held && last[1] == taps && last[2] < UINT8_MAX) {
+      last[2]++;
+      return;
+    }
+  }
+
+  if (recordingLength + INPUT_LOG_ENTRY_SIZE > recordingSize) {
+    recording = nullptr;  // full
+    return;
+  }
+
+  uint8_t *entry = recording + recordingLength;
+  entry[0] = held;
+  entry[1] = taps;
+  entry[2] = 1;
+  recordingLength += INPUT_LOG_ENTRY_SIZE;
+}
+
+void Input::startReplay(const uint8_t *log, uint16_t length) {
+  replayLength = length - length % INPUT_LOG_ENTRY_SIZE;
+  replayPosition = 0;
+  replayTicks = 0;
+  replayLog = log;
+}
 
-        if (dPadEvent) {
-          publish(&dPadMessage);
+void Input::stopReplay() {
+  replayLog = nullptr;
+}
+
+// returns false once the last tick of the log has been replayed
+bool Input::replayTick(uint32_t time) {
+  if (replayPosition >= replayLength) {
+    return false;
+  }
+
+  const uint8_t *entry = replayLog + replayPosition;
+  uint8_t buttons = entry[0], taps = entry[1];
+
+  core_util_critical_section_enter();
+  for (uint8_t i = 0; i < BUTTON_COUNT; i++) {
+    uint8_t mask = buttonMask((Button)i);
+
+    if (taps & mask) {
+      // back to where it started, then on to `buttons` below
+      bool wasHeld = captured & mask;
+      pushEdge((Button)i, !wasHeld, time, time);
+      pushEdge((Button)i, wasHeld, time, time);
+    }
+
+    if ((captured ^ buttons) & mask) {
+      captured ^= mask;
+      lastEdgeAt[i] = time;
+      pushEdge((Button)i, buttons & mask, time, time);
+    }
+  }
+  core_util_critical_section_exit();
+
+  if (++replayTicks >= entry[2]) {
+    replayPosition += INPUT_LOG_ENTRY_SIZE;
+    replayTicks = 0;
+  }
+
+  return replayPosition < replayLength;
+}
+
+void Input::publishEdges() {
+  bool inputEvent = false, dPadEvent = false;
+  bool inputPressedEvent = false, dPadPressedEvent = false;
+
+  bool *pressedFlags[BUTTON_COUNT] = {
+    &buttonLeftPressed,
+    &buttonRightPressed,
+    &dPadLeftPressed,
+    &dPadRightPressed,
+    &dPadUpPressed,
+    &dPadDownPressed,
+    &dPadCenterPressed,
+  };
+
+  // only this actor moves the head, so the edges up to the tail are ours
+  while (edgesHead != edgesTail) {
+    Edge edge = edges[edgesHead % INPUT_EDGE_QUEUE_SIZE];
+    edgesHead = edgesHead + 1;
+
+    *pressedFlags[edge.button] = edge.pressed;
+
+    uint8_t mask = buttonMask(edge.button);
+    if (edge.pressed) {
+      held |= mask;
+      pressed |= mask;
+    } else {
+      held &= ~mask;
+      released |= mask;
+    }
+
+    if (options.getButtonEvents()) {
+      ::Actor::Message message(edge.pressed ? pressedSignals[edge.button] : releasedSignals[edge.button]);
+      message.setPayload(ButtonEvent{ edge.time, edge.button, edge.since });
+      publish(message);
+    }
+    stats.record(micros() - edge.time, edge.time - edge.since);
+
+    bool dPad = edge.button >= D_PAD_LEFT;
+    inputEvent = true;
+    dPadEvent |= dPad;
+    inputPressedEvent |= edge.pressed;
+    dPadPressedEvent |= dPad && edge.pressed;
+  }
+
+  if (!options.getButtonEvents()) {
+    return;
+  }
+
+  if (inputEvent) {
+    publish(::Actor::Message(Events::INPUT));
+  }
+
+  if (inputPressedEvent) {
+    publish(::Actor::Message(Events::INPUT_PRESSED));
+  }
+
+  if (dPadEvent) {
+    publish(::Actor::Message(Events::D_PAD));
+  }
+
+  if (dPadPressedEvent) {
+    publish(::Actor::Message(Events::D_PAD_PRESSED));
+  }
+}
+
+// subscribers that take everything already get the per-button messages
+Input::Input() {
+  setExplicitSignals(::Actor::signalMask(Events::INPUT_STATE));
+}
+
+void Input::initialize() {
+  lastReadAt = micros();
+  for (uint8_t i = 0; i < BUTTON_COUNT; i++) {
+    pinMode(buttonPins[i], INPUT_PULLUP);
+  }
+
+  if (options.getInterrupts()) {
+    interruptInput = this;
+    for (uint8_t i = 0; i < BUTTON_COUNT; i++) {
+      attachInterrupt(digitalPinToInterrupt(buttonPins[i]), inputInterruptCallback, CHANGE);
+    }
+  }
+}
+
+void Input::handle(::Actor::Message *message) {
+  switch (message->signal) {
+    case Events::TICK:
+      {
+        // with interrupts this only catches releases and presses that were
+        // hidden by debouncing
+        uint32_t time = micros();
+        bool finished = false;
+
+        if (replayLog) {
+          finished = !replayTick(time);
+        } else {
+          // anything that changed since the last read, a tick ago when
+          // polling, could have happened any time after it
+          core_util_critical_section_enter();
+          capture(readButtons(), time, lastReadAt);
+          core_util_critical_section_exit();
         }
 
-        if (dPadPressedEvent) {
-          publish(&dPadPressedMessage);
+        publishEdges();
+
+        // one message for everything that happened this tick
+        ::Actor::Message message(Events::INPUT_STATE);
+        message.setPayload(InputState{ time, held, pressed, released });
+        publish(message);
+
+        if (recording) {
+          recordTick();
         }
+        pressed = released = 0;
 
+        if (finished) {
+          replayLog = nullptr;
+          publish(::Actor::Message(Events::REPLAY_FINISHED));
+        }
+        break;
+      }
+    case Events::INPUT_CAPTURED:
+      {
+        publishEdges();
         break;
       }
     default:
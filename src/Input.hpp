@@ -17,40 +17,209 @@ namespace Kywy {
 #define KYWY_D_PAD_RIGHT 7
 #define KYWY_D_PAD_CENTER 8
 
+// edges captured by interrupts that can wait to be published, a power of two
+#define INPUT_EDGE_QUEUE_SIZE 32
+
+// bytes per entry of an input log, see `Input::startRecording`
+#define INPUT_LOG_ENTRY_SIZE 3
+
+typedef enum : uint8_t {
+  BUTTON_LEFT,
+  BUTTON_RIGHT,
+  D_PAD_LEFT,
+  D_PAD_RIGHT,
+  D_PAD_UP,
+  D_PAD_DOWN,
+  D_PAD_CENTER,
+  BUTTON_COUNT,
+} Button;
+
+// bit per `Button`, e.g. `state.held & buttonMask(BUTTON_LEFT)`
+inline uint8_t buttonMask(Button button) {
+  return 1 << button;
+}
+
+#define D_PAD_BUTTONS 0x7c  // every d-pad direction and center
+
+struct InputOptions {
+  bool _interrupts = false;
+  uint16_t _debounce = 10;
+  bool _buttonEvents = true;
+
+  // catch presses and releases with GPIO interrupts and publish them right
+  // away, instead of reading the buttons once per tick
+  InputOptions interrupts(bool setInterrupts) {
+    _interrupts = setInterrupts;
+    return *this;
+  };
+  bool getInterrupts() {
+    return _interrupts;
+  };
+
+  // milliseconds after a press or release that further changes to the same
+  // button are treated as contact bounce
+  InputOptions debounce(uint16_t setDebounce) {
+    _debounce = setDebounce;
+    return *this;
+  };
+  uint16_t getDebounce() {
+    return _debounce;
+  };
+
+  // publish a message for every press and release (and INPUT, D_PAD, ...).
+  // INPUT_STATE is only sent to actors that subscribe to it by name, so it
+  // adds to these rather than replacing them, turn them off if every actor
+  // only uses INPUT_STATE (see `EngineOptions::buttonEvents`)
+  InputOptions buttonEvents(bool setButtonEvents) {
+    _buttonEvents = setButtonEvents;
+    return *this;
+  };
+  bool getButtonEvents() {
+    return _buttonEvents;
+  };
+};
+
+// Payload of INPUT_STATE, published once per tick to actors that subscribe to
+// it by name, e.g.
+//   engine.start(Kywy::EngineOptions().buttonEvents(false));
+//   subscribe(&engine.input, ::Actor::signalMask(Kywy::Events::INPUT_STATE));
+// where turning off button events leaves it the only input message.
+// Masks have a bit per `Button`, so combinations can be checked at once, e.g.
+//   (state.held & (buttonMask(BUTTON_LEFT) | buttonMask(BUTTON_RIGHT))) == ...
+struct InputState {
+  uint32_t time;     // micros() of the tick
+  uint8_t held;      // buttons down at the tick
+  uint8_t pressed;   // buttons pressed since the last INPUT_STATE
+  uint8_t released;  // buttons released since the last INPUT_STATE, a quick
+                     // tap can be both pressed and released
+};
+
+// Payload of every button *_PRESSED and *_RELEASED message. The change
+// happened after `since` and was seen at `time`, when polling that is between
+// two reads of the buttons, a tick apart. With interrupts, and for injected or
+// replayed input, both are the same.
+struct ButtonEvent {
+  uint32_t time;   // micros() when the press or release was seen
+  Button button;
+  uint32_t since;  // micros() of the read before, when it hadn't happened yet
+};
+
+// Time between a press or release being seen and it being published, and
+// before that how long it could have gone unseen (`ButtonEvent::time - since`),
+// in microseconds. A press waits half the unseen time on average, so from
+// press to publish is about `getAverageLatency() + getAverageUnseen() / 2`.
+struct InputStats {
+  uint32_t edges = 0;    // presses and releases published
+  uint32_t bounces = 0;  // changes ignored by debouncing
+  uint32_t dropped = 0;  // edges lost because too many were waiting
+  uint32_t maxLatency = 0;
+  uint64_t totalLatency = 0;
+  uint32_t maxUnseen = 0;
+  uint64_t totalUnseen = 0;
+
+  void record(uint32_t latency, uint32_t unseen) {
+    edges++;
+    totalLatency += latency;
+    maxLatency = latency > maxLatency ? latency : maxLatency;
+    totalUnseen += unseen;
+    maxUnseen = unseen > maxUnseen ? unseen : maxUnseen;
+  };
+  uint32_t getAverageLatency() {
+    return edges ? totalLatency / edges : 0;
+  };
+  uint32_t getAverageUnseen() {
+    return edges ? totalUnseen / edges : 0;
+  };
+};
+
 class Input : public Actor::Actor {
 private:
-  bool _buttonLeftPressed;
-  bool _buttonRightPressed;
-  bool _dPadLeftPressed;
-  bool _dPadRightPressed;
-  bool _dPadUpPressed;
-  bool _dPadDownPressed;
-  bool _dPadCenterPressed;
-
-  ::Actor::Message inputMessage;
-  ::Actor::Message inputPressedMessage;
-  ::Actor::Message dPadMessage;
-  ::Actor::Message dPadPressedMessage;
-
-  ::Actor::Message buttonLeftPressedMessage;
-  ::Actor::Message buttonLeftReleasedMessage;
-  ::Actor::Message buttonRightPressedMessage;
-  ::Actor::Message buttonRightReleasedMessage;
-  ::Actor::Message dPadLeftPressedMessage;
-  ::Actor::Message dPadLeftReleasedMessage;
-  ::Actor::Message dPadRightPressedMessage;
-  ::Actor::Message dPadRightReleasedMessage;
-  ::Actor::Message dPadUpPressedMessage;
-  ::Actor::Message dPadUpReleasedMessage;
-  ::Actor::Message dPadDownPressedMessage;
-  ::Actor::Message dPadDownReleasedMessage;
-  ::Actor::Message dPadCenterPressedMessage;
-  ::Actor::Message dPadCenterReleasedMessage;
+  struct Edge {
+    uint32_t time;
+    uint32_t since;
+    Button button;
+    bool pressed;
+  };
+
+  // written with interrupts disabled (or from the interrupt), read by the
+  // input actor
+  Edge edges[INPUT_EDGE_QUEUE_SIZE];
+  volatile uint8_t edgesHead = 0;  // next edge to publish
+  volatile uint8_t edgesTail = 0;  // next free slot
+
+  uint8_t captured = 0;  // debounced buttons held, bit per `Button`
+  uint32_t lastEdgeAt[BUTTON_COUNT] = {};
+  uint32_t lastReadAt = 0;  // micros() the buttons were last read
+
+  // published so far, for INPUT_STATE
+  uint8_t held = 0;
+  uint8_t pressed = 0;
+  uint8_t released = 0;
+
+  uint8_t *recording = nullptr;
+  uint16_t recordingSize = 0;
+  uint16_t recordingLength = 0;
+
+  const uint8_t *replayLog = nullptr;
+  uint16_t replayLength = 0;
+  uint16_t replayPosition = 0;
+  uint8_t replayTicks = 0;  // ticks of the current entry replayed so far
+
+  void recordTick();
+  bool replayTick(uint32_t time);
+
+  uint8_t readButtons();
+  void capture(uint8_t buttons, uint32_t time, uint32_t since);
+  void pushEdge(Button button, bool pressed, uint32_t time, uint32_t since);
+  void publishEdges();
+
+  friend void inputInterruptCallback();
 
 public:
+  Input();
+
+  const char *getName() {
+    return "input";
+  };
   void initialize();
   void handle(::Actor::Message *message);
 
+  // Queues a press or release as if it came from the hardware, `time` is the
+  // micros() it happened at. Safe to call from any thread or interrupt.
+  void inject(Button button, bool pressed, uint32_t time);
+
+  InputOptions options;
+  InputStats stats;
+
+  // buttons down as of the last published press or release, bit per `Button`
+  uint8_t getHeld() {
+    return held;
+  };
+
+  // Log the buttons every tick into `buffer` until `stopRecording`, which
+  // returns the bytes used. A log is a list of `INPUT_LOG_ENTRY_SIZE` byte
+  // entries: buttons held, buttons tapped (both pressed and released within
+  // the tick), then how many ticks in a row that was the case. Recording stops
+  // when the buffer is full.
+  void startRecording(uint8_t *buffer, uint16_t size);
+  uint16_t stopRecording();
+  bool isRecording() {
+    return recording != nullptr;
+  };
+
+  // Take the buttons from a recorded log instead of the hardware, a tick at a
+  // time. REPLAY_FINISHED is published right after the INPUT_STATE of the
+  // last tick in the log, then the hardware takes over again.
+  void startReplay(const uint8_t *log, uint16_t length);
+  void stopReplay();
+  bool isReplaying() {
+    return replayLog != nullptr;
+  };
+
+  // kept up to date for older sketches, see `getHeld` and INPUT_STATE. Input
+  // writes these from its handler under `handlerMutex`, only read them from
+  // handlers that hold it too.
+
   bool buttonLeftPressed;
   bool buttonRightPressed;
   bool dPadLeftPressed;
@@ -60,6 +229,10 @@ public:
   bool dPadCenterPressed;
 };
 
+// GPIO interrupt callback that captures button changes for the started input
+// actor
+void inputInterruptCallback();
+
 }  // namespace Kywy
 
 #endif
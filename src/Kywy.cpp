@@ -10,19 +10,40 @@ void Engine::start(EngineOptions options) {
   this->options = options;
   Serial.begin(9600);
 
-  displayDriver = new Display::Driver::MBED_SPI_DRIVER();
+  ::Actor::setSchedulerMode(options.getCooperativeScheduler()
+                              ? ::Actor::SCHEDULER_COOPERATIVE
+                              : ::Actor::SCHEDULER_THREADED);
+
+  Display::Driver::MBED_SPI_DRIVER *mbedDriver = new Display::Driver::MBED_SPI_DRIVER();
+  mbedDriver->setDoubleBuffering(options.getDoubleBufferDisplay());
+  displayDriver = mbedDriver;
   display = Display::Display(displayDriver);
 
+  // the engine only forwards messages, the clock only publishes and the
+  // console locks the display itself, so they don't wait for game actors'
+  // handlers. Input keeps the default lock, game handlers read the button
+  // state it writes on every tick.
+  setHandlerLock(nullptr);
+  clock.setHandlerLock(nullptr);
+  console.setHandlerLock(nullptr);
+
   Actor::Actor::start();
 
   clock.options.clickToTick(options.getClickToClick());
+  clock.options.fixedTimestep(options.getFixedTimestep());
   clock.start();
 
+  input.options.interrupts(options.getInterruptInput());
+  input.options.buttonEvents(options.getButtonEvents());
   input.subscribe(&clock);  // get inputs for every tick
   input.start();
 
   display.setup();
   battery.setup();
+
+  if (options.getConsole() || options.getClickToClick()) {
+    console.start();
+  }
 }
 
 void Engine::initialize() {}
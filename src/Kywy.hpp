@@ -12,8 +12,13 @@
 #include "Font.hpp"
 #include "Fonts.hpp"
 #include "Clock.hpp"
+#include "Collider.hpp"
+#include "Compositor.hpp"
+#include "Console.hpp"
 #include "Events.hpp"
+#include "FixedPoint.hpp"
 #include "Input.hpp"
+#include "Profiler.hpp"
 #include "Sprite.hpp"
 #include "SpriteSheet.hpp"
 
@@ -21,6 +26,12 @@ namespace Kywy {
 
 struct EngineOptions {
   bool _clickToTick = false;
+  bool _doubleBufferDisplay = false;
+  bool _cooperativeScheduler = false;
+  bool _fixedTimestep = false;
+  bool _interruptInput = false;
+  bool _buttonEvents = true;
+  bool _console = false;
 
   EngineOptions clickToTick(bool setClickToTick) {
     _clickToTick = setClickToTick;
@@ -29,16 +40,77 @@ struct EngineOptions {
   bool getClickToClick() {
     return _clickToTick;
   };
+
+  // flush the display in the background so actors can keep drawing while the
+  // previous frame is sent, see `Display::Driver::MBED_SPI_DRIVER::setDoubleBuffering`
+  EngineOptions doubleBufferDisplay(bool setDoubleBufferDisplay) {
+    _doubleBufferDisplay = setDoubleBufferDisplay;
+    return *this;
+  };
+  bool getDoubleBufferDisplay() {
+    return _doubleBufferDisplay;
+  };
+
+  // run every actor from a single thread instead of one thread per actor, see
+  // `Actor::setSchedulerMode`
+  EngineOptions cooperativeScheduler(bool setCooperativeScheduler) {
+    _cooperativeScheduler = setCooperativeScheduler;
+    return *this;
+  };
+  bool getCooperativeScheduler() {
+    return _cooperativeScheduler;
+  };
+
+  // see `ClockOptions::fixedTimestep`
+  EngineOptions fixedTimestep(bool setFixedTimestep) {
+    _fixedTimestep = setFixedTimestep;
+    return *this;
+  };
+  bool getFixedTimestep() {
+    return _fixedTimestep;
+  };
+
+  // see `InputOptions::interrupts`
+  EngineOptions interruptInput(bool setInterruptInput) {
+    _interruptInput = setInterruptInput;
+    return *this;
+  };
+  bool getInterruptInput() {
+    return _interruptInput;
+  };
+
+  // see `InputOptions::buttonEvents`, turn off along with subscribing to
+  // INPUT_STATE to get one input message per tick instead of one per press
+  EngineOptions buttonEvents(bool setButtonEvents) {
+    _buttonEvents = setButtonEvents;
+    return *this;
+  };
+  bool getButtonEvents() {
+    return _buttonEvents;
+  };
+
+  // read debug commands from Serial, see `Console`, click to tick turns it on
+  EngineOptions console(bool setConsole) {
+    _console = setConsole;
+    return *this;
+  };
+  bool getConsole() {
+    return _console;
+  };
 };
 
 class Engine : public ::Actor::Actor {
 public:
+  const char *getName() {
+    return "engine";
+  };
   void start(EngineOptions options = EngineOptions());
   void initialize();
   void handle(::Actor::Message *message);
 
   Clock clock;
   Input input;
+  Console console{ this };
   Display::Display display;
   Battery battery;
   EngineOptions options;
@@ -0,0 +1,81 @@
+// SPDX-FileCopyrightText: 2025 KOINSLOT, Inc.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "Message.hpp"
+
+#if defined(__MBED__)
+#include "mbed.h"
+#endif
+
+namespace Actor {
+
+MessagePool messagePool;
+
+// messages are acquired and released from every actor's thread and from
+// interrupts, on a single core a critical section is all the locking the pool
+// needs
+static inline void lockPool() {
+#if defined(__MBED__)
+  core_util_critical_section_enter();
+#endif
+}
+
+static inline void unlockPool() {
+#if defined(__MBED__)
+  core_util_critical_section_exit();
+#endif
+}
+
+MessagePool::MessagePool() {
+  for (uint16_t i = 0; i < MESSAGE_POOL_SIZE; i++) {
+    freeSlots[numFree++] = MESSAGE_POOL_SIZE - 1 - i;
+  }
+}
+
+Message *MessagePool::acquire(const Message &message, uint8_t references) {
+  lockPool();
+  if (!numFree) {
+    exhausted++;
+    unlockPool();
+    // TODO: error
+    return nullptr;  // pool exhausted
+  }
+
+  uint8_t slot = freeSlots[--numFree];
+  this->references[slot] = references;
+
+  uint16_t inUse = MESSAGE_POOL_SIZE - numFree;
+  highWater = inUse > highWater ? inUse : highWater;
+  unlockPool();
+
+  // the slot is ours now, copy outside the lock
+  slots[slot] = message;
+  return &slots[slot];
+}
+
+void MessagePool::release(Message *message) {
+  if (message < slots || message >= slots + MESSAGE_POOL_SIZE) {
+    return;  // not from the pool
+  }
+
+  uint8_t slot = message - slots;
+
+  lockPool();
+  if (references[slot] && !--references[slot]) {
+    freeSlots[numFree++] = slot;
+  }
+  unlockPool();
+}
+
+void MessagePool::retain(Message *message) {
+  if (message < slots || message >= slots + MESSAGE_POOL_SIZE) {
+    return;  // not from the pool
+  }
+
+  lockPool();
+  references[message - slots]++;
+  unlockPool();
+}
+
+}  // namespace Actor
@@ -0,0 +1,126 @@
+// SPDX-FileCopyrightText: 2025 KOINSLOT, Inc.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef KYWY_LIB_MESSAGE
+#define KYWY_LIB_MESSAGE 1
+
+#include <stdint.h>
+#include <string.h>
+
+namespace Actor {
+
+// bytes of data that can be copied into a message, see `Message::setPayload`
+// (fits `Kywy::Tick`)
+#define MESSAGE_PAYLOAD_SIZE 16
+
+// messages that can be waiting to be handled at once, across all actors
+#define MESSAGE_POOL_SIZE 64
+
+typedef enum : uint8_t {
+  DIRECTIVE_HANDLE,
+  DIRECTIVE_EXIT,
+} Directive;
+
+// only used by the cooperative scheduler, messages of the same priority are
+// handled in the order they were dispatched
+typedef enum : uint8_t {
+  PRIORITY_HIGH,
+  PRIORITY_NORMAL,
+  PRIORITY_LOW,
+  PRIORITY_LEVELS,
+} Priority;
+
+// Set of signals an actor subscribes to. Signals 0 through 62 get their own
+// bit, every signal above that shares the last bit.
+typedef uint64_t SignalMask;
+
+#define SIGNAL_MASK_ALL (~(::Actor::SignalMask)0)
+
+inline SignalMask signalMask(int signal) {
+  return (SignalMask)1 << (signal >= 0 && signal < 63 ? signal : 63);
+}
+
+struct Message {
+  Message()
+    : directive(DIRECTIVE_HANDLE), signal(0), data(nullptr), priority(PRIORITY_NORMAL), coalesce(false) {}
+  Message(int signal)
+    : directive(DIRECTIVE_HANDLE), signal(signal), data(nullptr), priority(PRIORITY_NORMAL), coalesce(false) {}
+  Message(int signal, void *data)
+    : directive(DIRECTIVE_HANDLE), signal(signal), data(data), priority(PRIORITY_NORMAL), coalesce(false) {}
+  Message(int signal, void *data, Priority priority)
+    : directive(DIRECTIVE_HANDLE), signal(signal), data(data), priority(priority), coalesce(false) {}
+  Directive directive;
+  int signal;
+  void *data;  // has to stay valid until every receiver has handled the message
+  Priority priority;  // only used by the cooperative scheduler
+
+  // For signals where only the latest one matters (like TICK): while one is
+  // waiting to be handled by an actor, more with the same signal are dropped
+  // for that actor instead of piling up behind it.
+  bool coalesce;
+
+  // Small values can be copied into the message itself instead of pointed to
+  // with `data`, then nothing has to be kept alive after dispatching.
+  uint8_t payload[MESSAGE_PAYLOAD_SIZE];
+
+  template <typename T>
+  void setPayload(const T &value) {
+    static_assert(sizeof(T) <= MESSAGE_PAYLOAD_SIZE, "payload too large");
+    memcpy(payload, &value, sizeof(T));
+  };
+  template <typename T>
+  T getPayload() {
+    static_assert(sizeof(T) <= MESSAGE_PAYLOAD_SIZE, "payload too large");
+    T value;
+    memcpy(&value, payload, sizeof(T));
+    return value;
+  };
+};
+
+// Fixed set of message slots that `dispatch` and `publish` copy messages into,
+// so senders don't have to keep their messages alive. A published message is
+// copied once and shared by every subscriber, the slot is freed when the last
+// one has handled it.
+class MessagePool {
+public:
+  MessagePool();
+
+  // copies `message` into a free slot that is freed after `references` calls
+  // to `release`, returns nullptr if every slot is in use
+  Message *acquire(const Message &message, uint8_t references);
+
+  // drops one reference to a message, messages that didn't come from the pool
+  // are ignored
+  void release(Message *message);
+
+  // adds a reference to a message from the pool
+  void retain(Message *message);
+
+  uint16_t getInUse() {
+    return MESSAGE_POOL_SIZE - numFree;
+  };
+  uint16_t getHighWater() {
+    return highWater;
+  };
+  // number of messages dropped because the pool was empty
+  uint32_t getExhausted() {
+    return exhausted;
+  };
+
+private:
+  Message slots[MESSAGE_POOL_SIZE];
+  uint8_t references[MESSAGE_POOL_SIZE] = {};
+
+  uint8_t freeSlots[MESSAGE_POOL_SIZE];
+  uint16_t numFree = 0;
+
+  uint16_t highWater = 0;
+  uint32_t exhausted = 0;
+};
+
+extern MessagePool messagePool;
+
+}  // namespace Actor
+
+#endif
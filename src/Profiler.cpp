@@ -0,0 +1,162 @@
+// SPDX-FileCopyrightText: 2025 KOINSLOT, Inc.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "Profiler.hpp"
+#include "Actor.hpp"
+
+namespace Profiler {
+
+static_assert(sizeof(Record) == 16, "profiler records are dumped as is");
+
+static void writeHeader(Print &out, uint16_t numRecords, uint32_t written,
+                        uint8_t numActors) {
+  uint8_t header[12] = {
+    'K', 'Y', 'P', 'F',
+    PROFILER_FORMAT_VERSION,
+    sizeof(Record),
+    (uint8_t)numRecords, (uint8_t)(numRecords >> 8),
+    (uint8_t)written, (uint8_t)(written >> 8), (uint8_t)(written >> 16), (uint8_t)(written >> 24)
+  };
+  out.write(header, sizeof(header));
+  out.write(numActors);
+}
+
+#ifdef KYWY_PROFILER
+
+static Record records[PROFILER_RECORDS];
+static volatile uint32_t recordsWritten = 0;  // records[recordsWritten % PROFILER_RECORDS] is next
+static volatile bool paused = false;
+
+// actors get an id the first time they post or handle a message
+static Actor::Actor *actors[PROFILER_MAX_ACTORS] = {};
+static volatile uint8_t numActors = 0;
+static volatile uint16_t pending[PROFILER_MAX_ACTORS] = {};  // messages queued per actor
+static volatile uint8_t currentActor = PROFILER_NO_ACTOR;
+
+static uint8_t getActorId(Actor::Actor *actor) {
+  for (uint8_t i = 0; i < numActors; i++) {
+    if (actors[i] == actor) {
+      return i;
+    }
+  }
+
+  core_util_critical_section_enter();
+  uint8_t i = 0;
+  while (i < numActors && actors[i] != actor) {  // another thread may have added it
+    i++;
+  }
+  if (i == numActors) {
+    if (numActors == PROFILER_MAX_ACTORS) {
+      i = PROFILER_MAX_ACTORS - 1;  // out of ids
+    } else {
+      actors[numActors++] = actor;
+    }
+  }
+  core_util_critical_section_exit();
+
+  return i;
+}
+
+// claims the next slot without locking, overwriting the oldest record
+static Record *claimRecord() {
+  if (paused) {
+    return nullptr;
+  }
+
+  uint32_t index = core_util_atomic_incr_u32(&recordsWritten, 1) - 1;
+  return &records[index % PROFILER_RECORDS];
+}
+
+void posted(Actor::Actor *actor) {
+  core_util_atomic_incr_u16(&pending[getActorId(actor)], 1);
+}
+
+void unposted(Actor::Actor *actor) {
+  core_util_atomic_decr_u16(&pending[getActorId(actor)], 1);
+}
+
+uint32_t beginHandle(Actor::Actor *actor) {
+  currentActor = getActorId(actor);
+  return micros();
+}
+
+void endHandle(Actor::Actor *actor, int signal, uint32_t start,
+               uint32_t postedAt) {
+  uint32_t duration = micros() - start;
+  uint8_t id = getActorId(actor);
+  currentActor = PROFILER_NO_ACTOR;
+
+  // depth includes the message just handled
+  uint16_t depth = pending[id];
+  if (depth) {
+    core_util_atomic_decr_u16(&pending[id], 1);
+  }
+
+  Record *record = claimRecord();
+  if (record == nullptr) {
+    return;
+  }
+
+  uint32_t wait = start - postedAt;
+  record->type = RECORD_HANDLE;
+  record->actor = id;
+  record->id = signal;
+  record->start = start;
+  record->duration = duration;
+  record->wait = wait > UINT16_MAX ? UINT16_MAX : wait;
+  record->depth = depth > UINT8_MAX ? UINT8_MAX : depth;
+  record->reserved = 0;
+}
+
+void record(RecordType type, uint16_t id, uint32_t start) {
+  uint32_t duration = micros() - start;
+
+  Record *record = claimRecord();
+  if (record == nullptr) {
+    return;
+  }
+
+  record->type = type;
+  record->actor = currentActor;
+  record->id = id;
+  record->start = start;
+  record->duration = duration;
+  record->wait = 0;
+  record->depth = 0;
+  record->reserved = 0;
+}
+
+void dump(Print &out) {
+  paused = true;
+
+  uint32_t written = recordsWritten;
+  uint16_t numRecords = written < PROFILER_RECORDS ? written : PROFILER_RECORDS;
+
+  writeHeader(out, numRecords, written, numActors);
+
+  for (uint8_t i = 0; i < numActors; i++) {
+    const char *name = actors[i]->getName();
+    uint8_t length = name ? strnlen(name, UINT8_MAX) : 0;
+    out.write(i);
+    out.write(length);
+    out.write((const uint8_t *)name, length);
+  }
+
+  for (uint16_t i = 0; i < numRecords; i++) {
+    out.write((const uint8_t *)&records[(written - numRecords + i) % PROFILER_RECORDS],
+              sizeof(Record));
+  }
+
+  paused = false;
+}
+
+#else
+
+void dump(Print &out) {
+  writeHeader(out, 0, 0, 0);
+}
+
+#endif
+
+}  // namespace Profiler
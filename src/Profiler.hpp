@@ -0,0 +1,108 @@
+// SPDX-FileCopyrightText: 2025 KOINSLOT, Inc.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef KYWY_LIB_PROFILER
+#define KYWY_LIB_PROFILER 1
+
+#include <Arduino.h>
+#include <stdint.h>
+
+// Records how long actor handlers, draw calls and display updates take into a
+// ring buffer that can be dumped over Serial and read with
+// `scripts/profile_decoder.py`.
+//
+// Only compiled in when the whole build (library and sketch) defines
+// KYWY_PROFILER, e.g. `make compile t=examples/<example> profile=1`. Otherwise
+// every hook compiles away and `dump` writes an empty profile.
+
+#define PROFILER_RECORDS 512      // records kept, the oldest are overwritten
+#define PROFILER_MAX_ACTORS 32    // actors beyond this share the last id
+#define PROFILER_FORMAT_VERSION 1
+#define PROFILER_NO_ACTOR 0xff    // records made outside of any handler
+
+namespace Actor {
+class Actor;
+}
+
+namespace Profiler {
+
+typedef enum : uint8_t {
+  RECORD_HANDLE,  // an actor handling a message, `id` is the signal
+  RECORD_UPDATE,  // `Display::update`, marks the end of a frame
+  RECORD_DRAW,    // a draw call, `id` is a `DrawCall`
+} RecordType;
+
+typedef enum : uint8_t {
+  DRAW_LINE,
+  DRAW_CIRCLE,
+  FILL_CIRCLE,
+  DRAW_RECTANGLE,
+  FILL_RECTANGLE,
+  DRAW_BITMAP,
+  DRAW_TEXT,
+  DRAW_ARC,
+  DRAW_ELLIPSE,
+  FILL_ELLIPSE,
+  DRAW_ROUNDED_RECTANGLE,
+  FILL_ROUNDED_RECTANGLE,
+} DrawCall;
+
+// 16 bytes, written out as is (little endian)
+struct Record {
+  RecordType type;
+  uint8_t actor;    // actor that was handling a message, see `dump` for names
+  uint16_t id;      // signal or `DrawCall`
+  uint32_t start;   // micros()
+  uint32_t duration;
+  uint16_t wait;    // handlers only: time queued, microseconds (saturates)
+  uint8_t depth;    // handlers only: messages queued for the actor (saturates)
+  uint8_t reserved;
+};
+
+// Writes the recorded profile:
+//   "KYPF", version (u8), record size (u8), records (u16), records written
+//   since start (u32), actor names (u8), then per actor id (u8), name length
+//   (u8), name, then the records oldest first.
+// Recording is paused while dumping.
+void dump(Print &out);
+
+#ifdef KYWY_PROFILER
+
+// called by actors around posting and handling messages, draw calls made
+// between `beginHandle` and `endHandle` are attributed to the actor (which can
+// be wrong while actors without a handler lock run in parallel)
+void posted(Actor::Actor *actor);
+void unposted(Actor::Actor *actor);  // the post failed
+uint32_t beginHandle(Actor::Actor *actor);
+void endHandle(Actor::Actor *actor, int signal, uint32_t start,
+               uint32_t postedAt);
+
+void record(RecordType type, uint16_t id, uint32_t start);
+
+// records the time from construction to destruction
+class Scope {
+public:
+  Scope(RecordType type, uint16_t id)
+    : type(type), id(id), start(micros()) {}
+  ~Scope() {
+    record(type, id, start);
+  }
+
+private:
+  RecordType type;
+  uint16_t id;
+  uint32_t start;
+};
+
+#define PROFILE_SCOPE(type, id) ::Profiler::Scope profilerScope(type, id)
+
+#else
+
+#define PROFILE_SCOPE(type, id)
+
+#endif
+
+}  // namespace Profiler
+
+#endif
@@ -57,7 +57,7 @@ void Scene::enter() {
     }
 
     actors[i]->enable();
-    actors[i]->dispatch(&sceneEnterMessage);
+    actors[i]->dispatch(::Actor::Message(Kywy::Events::KywyEvents::SCENE_ENTER));
 
     i++;
   }
@@ -76,7 +76,7 @@ void Scene::exit() {
     }
 
     actors[i]->disable();
-    actors[i]->dispatch(&sceneExitMessage);
+    actors[i]->dispatch(::Actor::Message(Kywy::Events::KywyEvents::SCENE_EXIT));
 
     i++;
   }
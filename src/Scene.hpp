@@ -15,9 +15,6 @@ private:
   Actor::Actor *actors[MAX_ACTORS] = {};
   bool active = false;
 
-  ::Actor::Message sceneEnterMessage = ::Actor::Message(Kywy::Events::KywyEvents::SCENE_ENTER);
-  ::Actor::Message sceneExitMessage = ::Actor::Message(Kywy::Events::KywyEvents::SCENE_EXIT);
-
 public:
   Scene(){};
   ~Scene(){};
@@ -0,0 +1,93 @@
+// SPDX-FileCopyrightText: 2025 KOINSLOT, Inc.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "Scheduler.hpp"
+
+#if defined(__MBED__)
+#include "mbed.h"
+#endif
+
+namespace Actor {
+
+// messages are posted from other threads and interrupts (the clock, input), on
+// a single core a critical section is all the locking the queue needs
+static inline void lockQueue() {
+#if defined(__MBED__)
+  core_util_critical_section_enter();
+#endif
+}
+
+static inline void unlockQueue() {
+#if defined(__MBED__)
+  core_util_critical_section_exit();
+#endif
+}
+
+bool Scheduler::post(Actor *actor, Message *message, Priority priority,
+                     uint32_t postedAt) {
+  if (priority >= PRIORITY_LEVELS) {
+    priority = PRIORITY_LOW;
+  }
+
+  lockQueue();
+
+  Level &level = levels[priority];
+  if (level.count == SCHEDULER_QUEUE_SIZE) {
+    dropped++;
+    unlockQueue();
+    // TODO: error
+    return false;  // queue full
+  }
+
+  Entry &entry = level.entries[(level.head + level.count) % SCHEDULER_QUEUE_SIZE];
+  entry.actor = actor;
+  entry.message = message;
+  entry.postedAt = postedAt;
+  level.count++;
+
+  uint16_t queued = 0;
+  for (uint8_t i = 0; i < PRIORITY_LEVELS; i++) {
+    queued += levels[i].count;
+  }
+  highWater = queued > highWater ? queued : highWater;
+
+  unlockQueue();
+  return true;
+}
+
+bool Scheduler::runOnce() {
+  Entry entry;
+  bool found = false;
+
+  lockQueue();
+  for (uint8_t i = 0; i < PRIORITY_LEVELS && !found; i++) {
+    Level &level = levels[i];
+    if (level.count) {
+      entry = level.entries[level.head];
+      level.head = (level.head + 1) % SCHEDULER_QUEUE_SIZE;
+      level.count--;
+      found = true;
+    }
+  }
+  unlockQueue();
+
+  // handle outside the lock so the handler can dispatch more messages
+  if (found) {
+    handler(entry.actor, entry.message, entry.postedAt);
+  }
+
+  return found;
+}
+
+uint16_t Scheduler::getQueued() {
+  lockQueue();
+  uint16_t queued = 0;
+  for (uint8_t i = 0; i < PRIORITY_LEVELS; i++) {
+    queued += levels[i].count;
+  }
+  unlockQueue();
+  return queued;
+}
+
+}  // namespace Actor
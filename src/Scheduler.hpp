@@ -0,0 +1,73 @@
+// SPDX-FileCopyrightText: 2025 KOINSLOT, Inc.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef KYWY_LIB_SCHEDULER
+#define KYWY_LIB_SCHEDULER 1
+
+#include "Message.hpp"
+
+#include <stdint.h>
+
+namespace Actor {
+
+// number of messages each priority level can hold before messages are dropped
+#define SCHEDULER_QUEUE_SIZE 64
+
+class Actor;
+
+typedef enum : uint8_t {
+  SCHEDULER_THREADED,     // every actor runs on its own thread and event queue
+  SCHEDULER_COOPERATIVE,  // every actor shares a single thread and queue
+} SchedulerMode;
+
+// Queue of messages shared by every actor in cooperative mode. It doesn't run
+// anything on its own, whoever owns it calls `runOnce` in a loop, which keeps
+// it free of any RTOS dependencies.
+class Scheduler {
+public:
+  typedef void (*Handler)(Actor *actor, Message *message, uint32_t postedAt);
+
+  Scheduler(Handler handler)
+    : handler(handler) {}
+
+  // safe to call from any thread or interrupt, returns false if the message
+  // was dropped because its priority level is full
+  bool post(Actor *actor, Message *message, Priority priority,
+            uint32_t postedAt);
+
+  // handles the oldest of the highest priority messages, returns false if
+  // there was nothing to handle
+  bool runOnce();
+
+  uint16_t getQueued();
+  uint16_t getHighWater() {
+    return highWater;
+  };
+  uint32_t getDropped() {
+    return dropped;
+  };
+
+private:
+  struct Entry {
+    Actor *actor;
+    Message *message;
+    uint32_t postedAt;
+  };
+
+  struct Level {
+    Entry entries[SCHEDULER_QUEUE_SIZE];
+    uint16_t head = 0;  // next entry to handle
+    uint16_t count = 0;
+  };
+
+  Handler handler;
+  Level levels[PRIORITY_LEVELS];
+
+  uint16_t highWater = 0;
+  uint32_t dropped = 0;
+};
+
+}  // namespace Actor
+
+#endif
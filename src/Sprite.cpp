@@ -2,9 +2,9 @@
 //
 // SPDX-License-Identifier: GPL-3.0-or-later
 
-#include <math.h>
 #include <stdint.h>
 
+#include "FixedPoint.hpp"
 #include "Sprite.hpp"
 
 Sprite::~Sprite() {
@@ -21,27 +21,50 @@ Sprite::Sprite(const uint8_t *frames[], uint16_t numFrames, int16_t width,
   }
 };
 
+Sprite::Sprite(const Display::BitmapView *frameViews, uint16_t numFrames,
+               int16_t width, int16_t height)
+  : numFrames(numFrames), width(width), height(height), frameViews(frameViews){};
+
 void Sprite::setFrame(uint16_t frame) {
+  if (frame != this->frame)
+    markDirty();
   this->frame = frame;
 }
 
 void Sprite::setNegative(bool negative) {
   this->negative = negative;
+  markDirty();
 }
 void Sprite::setColor(uint16_t color) {
   this->color = color ? 0xff : 0x00;
+  markDirty();
+}
+
+void Sprite::getBounds(int16_t &x, int16_t &y, uint16_t &width,
+                       uint16_t &height) {
+  x = this->x;
+  y = this->y;
+  width = this->width;
+  height = this->height;
+}
+
+void Sprite::drawFrame(int16_t x, int16_t y, uint16_t frame,
+                       Display::BitmapOptions options) {
+  if (frameViews) {
+    display->drawBitmap(x, y, frameViews[frame], options);
+  } else {
+    display->drawBitmap(x, y, width, height, frames[frame], options);
+  }
 }
 
 void Sprite::draw() {
-  display->drawBitmap(x, y, width, height, (uint8_t *)frames[frame],
-                      Display::BitmapOptions().negative(negative).color(color));
+  drawFrame(x, y, frame, Display::BitmapOptions().negative(negative).color(color));
   lastRenderedFrame = frame;
 }
 
 void Sprite::erase(int16_t lastRenderedX, int16_t lastRenderedY) {
-  display->drawBitmap(lastRenderedX, lastRenderedY, width, height,
-                      (uint8_t *)frames[lastRenderedFrame],
-                      Display::BitmapOptions().negative(negative).color(!color));
+  drawFrame(lastRenderedX, lastRenderedY, lastRenderedFrame,
+            Display::BitmapOptions().negative(negative).color(!color));
 }
 
 void Sprite::translate(int16_t x, int16_t y) {
@@ -49,8 +72,16 @@ void Sprite::translate(int16_t x, int16_t y) {
 };
 
 void Sprite::translate(int16_t x, int16_t y, int16_t distance) {
-  float scale = distance / sqrt(x * x + y * y);
-  this->setPosition(this->x + (x * scale), this->y + (y * scale));
+  if (!x && !y) {
+    return;  // no direction to move in
+  }
+
+  // (x, y) * distance / length in Q16.16, the new position is truncated
+  // towards zero
+  uint32_t length = FixedPoint::squareRoot64((uint64_t)((uint32_t)(x * x) + (uint32_t)(y * y)) << 32);
+  int64_t newX = (int64_t)this->x * FIXED_ONE + (int64_t)x * distance * ((int64_t)1 << 32) / length;
+  int64_t newY = (int64_t)this->y * FIXED_ONE + (int64_t)y * distance * ((int64_t)1 << 32) / length;
+  this->setPosition(newX / FIXED_ONE, newY / FIXED_ONE);
 };
 
 void Sprite::incrementFrame() {
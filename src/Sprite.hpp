@@ -18,6 +18,10 @@ public:
 
   Sprite(const uint8_t *frames[], uint16_t numFrames, int16_t width,
          int16_t height);
+  // frames drawn straight out of a bitmap, e.g. `SpriteSheet::frames`, the
+  // views aren't copied so they can be filled in after the sprite is made
+  Sprite(const Display::BitmapView *frameViews, uint16_t numFrames,
+         int16_t width, int16_t height);
 
   void setFrame(uint16_t frame);
 
@@ -40,7 +44,8 @@ public:
   int16_t width;
   int16_t height;
 
-  const uint8_t **frames;
+  const uint8_t **frames = nullptr;
+  const Display::BitmapView *frameViews = nullptr;  // used instead of `frames` if set
 
   bool negative = false;
   void setNegative(bool negative);
@@ -48,10 +53,14 @@ public:
   uint16_t color = 0x00;
   void setColor(uint16_t color);
 
+  void getBounds(int16_t &x, int16_t &y, uint16_t &width, uint16_t &height);
+
 protected:
   void draw();
   void erase(int16_t lastRenderedX, int16_t lastRenderedY);
 
+  void drawFrame(int16_t x, int16_t y, uint16_t frame, Display::BitmapOptions options);
+
 private:
   uint16_t lastRenderedFrame = 0;
 
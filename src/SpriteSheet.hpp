@@ -15,7 +15,8 @@ public:
               uint16_t numFrames);
   ~SpriteSheet();
 
-  // Specifies a frame on the sprite sheet
+  // Specifies a frame on the sprite sheet, frames are views into the sheet so
+  // they can be any size and start at any pixel
   void addFrame(uint16_t x, uint16_t y, uint16_t frameWidth, uint16_t frameHeight);
 
   // Specifies multiple frames on the sprite sheet, reads left to right and then
@@ -23,7 +24,12 @@ public:
   void addFrames(uint16_t x, uint16_t y, uint16_t frameWidth, uint16_t frameHeight, uint16_t numFrames);
 
   const uint8_t *sheet;
-  const uint8_t **frames;
+
+  // Views into `sheet`, one per added frame. These used to be heap copies
+  // (`const uint8_t **`, see CHANGELOG.md), pass them to the `Sprite`
+  // constructor that takes views, e.g. `Sprite slime(spriteSheet.frames, 3,
+  // 32, 32)`, or draw one with `Display::drawBitmap(x, y, spriteSheet.frames[i])`.
+  Display::BitmapView *frames;
 
   int16_t sheetWidth, sheetHeight;
   uint16_t numFrames;
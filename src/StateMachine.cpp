@@ -7,130 +7,177 @@
 namespace StateMachine {
 
 void StateMachine::initialize(State targetState) {
-  depth = 0;
+  uint8_t target = getNode(targetState);
+  if (target == NO_STATE) {
+    return;  // TODO: error
+  }
 
-  enterParentStates(targetState);
+  // enter all parents of the target state and then the target state
+  enterStates(NO_STATE, target);
 
   state = targetState;
+  stateNode = target;
 
-  Result result = { .type = RESULT_CHILD, .target = targetState };
-  while (result.target) {
-    result = (this->*(result.target))(Event{ .signal = EVENT_REQUEST_CHILD });
-    if (result.target) {
-      (this->*(result.target))(Event{ .signal = EVENT_ENTER });
-      state = result.target;
-    }
-  }
+  enterChildStates();
 };
 
-void StateMachine::enterParentStates(State targetState) {
-  Result result = (this->*(targetState))(Event{ .signal = EVENT_REQUEST_PARENT });
-
-  State parent = result.target;
-  if (parent) {
-    depth++;
-    if (depth == MAX_STATE_DEPTH) {
-      return;  // TODO: error
+uint8_t StateMachine::getNode(State targetState, uint8_t depth) {
+  for (uint8_t i = 0; i < nodeCount; i++) {
+    if (nodes[i].state == targetState) {
+      return i;
     }
-
-    enterParentStates(parent);
   }
 
-  (this->*(targetState))(Event{ .signal = EVENT_ENTER });
-};
-
-uint8_t StateMachine::getAncestry(State targetState, State ancestry[]) {
-  // call EVENT_REQUEST_PARENT until result.target is null
-  // store state along the way
-  // reverse list
-  depth = 0;
-  ancestry[depth] = targetState;
+  if (depth == MAX_STATE_DEPTH) {
+    return NO_STATE;  // TODO: error
+  }
 
-  State parent =
+  State parentState =
     (this->*(targetState))(Event{ .signal = EVENT_REQUEST_PARENT }).target;
 
-  while (parent) {
-    depth++;
-    if (depth == MAX_STATE_DEPTH) {
-      return 0;  // TODO: error
+  uint8_t parent = NO_STATE;
+  if (parentState) {
+    parent = getNode(parentState, depth + 1);
+    if (parent == NO_STATE) {
+      return NO_STATE;
     }
+  }
 
-    ancestry[depth] = parent;
-
-    parent = (this->*(parent))(Event{ .signal = EVENT_REQUEST_PARENT }).target;
+  if (nodeCount == MAX_STATES) {
+    return NO_STATE;  // TODO: error
   }
 
-  // reverse populated portion of list
-  // [D, C, B, A, null, null] -> [A, B, C, D, null, null]
-  for (uint8_t i = 0; i < (depth + 1) / 2; i++) {
-    State temporaryStore = ancestry[i];
-    ancestry[i] = ancestry[depth - i];
-    ancestry[depth - i] = temporaryStore;
+  nodes[nodeCount] = StateNode{
+    .state = targetState,
+    .parent = parent,
+    .depth = (uint8_t)(parent == NO_STATE ? 0 : nodes[parent].depth + 1),
+  };
+  return nodeCount++;
+}
+
+uint8_t StateMachine::getCommonAncestor(uint8_t source, uint8_t target) {
+  // climb to the same depth and then in step until the ancestries meet
+  while (nodes[source].depth > nodes[target].depth) {
+    source = nodes[source].parent;
+  }
+  while (nodes[target].depth > nodes[source].depth) {
+    target = nodes[target].parent;
+  }
+  while (source != target) {
+    source = nodes[source].parent;
+    target = nodes[target].parent;
   }
 
-  return depth;
-};
+  return source;
+}
 
-void StateMachine::transition(State targetState) {
-  // get current and target ancestry
-  State currentAncestry[MAX_STATE_DEPTH] = {};
-  uint8_t currentAncestryDepth = getAncestry(state, currentAncestry);
+bool StateMachine::getTransitionPath(State targetState, TransitionPath &path) {
+  for (uint8_t i = 0; i < transitionCount; i++) {
+    if (transitions[i].source == stateNode && transitions[i].target == targetState) {
+      path = transitions[i];
+      return true;
+    }
+  }
 
-  State targetAncestry[MAX_STATE_DEPTH] = {};
-  uint8_t targetAncestryDepth = getAncestry(targetState, targetAncestry);
+  uint8_t target = getNode(targetState);
+  if (target == NO_STATE) {
+    return false;  // TODO: error
+  }
 
-  if (currentAncestry[0] != targetAncestry[0]) {
-    return;  // TODO: error, need common ancestor
+  uint8_t commonAncestor = getCommonAncestor(stateNode, target);
+  if (commonAncestor == NO_STATE) {
+    return false;  // TODO: error, need common ancestor
   }
 
-  // find common ancestor
-  uint8_t i = 0;
-  while (currentAncestry[i] && targetAncestry[i] && currentAncestry[i] == targetAncestry[i]) {
-    i++;
+  path = TransitionPath{
+    .target = targetState,
+    .source = stateNode,
+    .targetNode = target,
+    .commonAncestor = commonAncestor,
+  };
+
+  transitions[nextTransition] = path;
+  nextTransition = (nextTransition + 1) % MAX_CACHED_TRANSITIONS;
+  if (transitionCount < MAX_CACHED_TRANSITIONS) {
+    transitionCount++;
   }
-  uint8_t commonAncestorIndex = i - 1;
 
-  // exit to common ancestor
-  for (uint8_t i = currentAncestryDepth; i > commonAncestorIndex; i--) {
-    Result result = (this->*(currentAncestry[i]))(Event{ .signal = EVENT_EXIT });
-    if (result.type == RESULT_ERROR)
-      return;  // TODO: error
+  return true;
+}
+
+bool StateMachine::enterStates(uint8_t ancestor, uint8_t target) {
+  // the path is found bottom up and entered top down
+  uint8_t path[MAX_STATE_DEPTH];
+  uint8_t length = 0;
+  for (uint8_t i = target; i != ancestor; i = nodes[i].parent) {
+    path[length++] = i;
   }
 
-  // enter to target state
-  for (uint8_t i = commonAncestorIndex + 1; i <= targetAncestryDepth; i++) {
-    Result result = (this->*(targetAncestry[i]))(Event{ .signal = EVENT_ENTER });
+  while (length) {
+    Result result = (this->*(nodes[path[--length]].state))(Event{ .signal = EVENT_ENTER });
     if (result.type == RESULT_ERROR)
-      return;  // TODO: error
+      return false;
   }
 
-  state = targetState;
+  return true;
+}
 
-  // enter any child states
-  Result result = { .type = RESULT_CHILD, .target = targetState };
+void StateMachine::enterChildStates() {
+  Result result = { .type = RESULT_CHILD, .target = state };
   while (result.target) {
     result = (this->*(result.target))(Event{ .signal = EVENT_REQUEST_CHILD });
     if (result.target) {
+      uint8_t child = getNode(result.target);
+      if (child == NO_STATE) {
+        return;  // TODO: error
+      }
+
       (this->*(result.target))(Event{ .signal = EVENT_ENTER });
       state = result.target;
+      stateNode = child;
     }
   }
 }
 
+void StateMachine::transition(State targetState) {
+  TransitionPath path;
+  if (!getTransitionPath(targetState, path)) {
+    return;
+  }
+
+  // exit to common ancestor
+  for (uint8_t i = stateNode; i != path.commonAncestor; i = nodes[i].parent) {
+    Result result = (this->*(nodes[i].state))(Event{ .signal = EVENT_EXIT });
+    if (result.type == RESULT_ERROR)
+      return;  // TODO: error
+  }
+
+  // enter to target state
+  if (!enterStates(path.commonAncestor, path.targetNode))
+    return;  // TODO: error
+
+  state = targetState;
+  stateNode = path.targetNode;
+
+  enterChildStates();
+}
+
 Result StateMachine::handle(Event event) {
-  return processEvent(state, event);
+  if (stateNode == NO_STATE)
+    return Result{ .type = RESULT_ERROR, .target = nullptr };  // not initialized
+
+  return processEvent(stateNode, event);
 }
 
-Result StateMachine::processEvent(State targetState, Event event) {
-  Result result = (this->*targetState)(event);
+Result StateMachine::processEvent(uint8_t node, Event event) {
+  Result result = (this->*(nodes[node].state))(event);
 
   switch (result.type) {
     case RESULT_UNHANDLED:
       {  // pass to parent to handle
-        State parent =
-          (this->*targetState)(Event{ .signal = EVENT_REQUEST_PARENT }).target;
-        if (!state)
-          return Result{ .type = RESULT_ERROR, .target = state };
+        uint8_t parent = nodes[node].parent;
+        if (parent == NO_STATE)
+          return Result{ .type = RESULT_ERROR, .target = nodes[node].state };
 
         return processEvent(parent, event);
       }
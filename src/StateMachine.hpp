@@ -9,6 +9,10 @@
 
 namespace StateMachine {
 const uint8_t MAX_STATE_DEPTH = 16;  // used to prevent infinite recursive loops
+const uint8_t MAX_STATES = 32;       // distinct states a machine can enter
+const uint8_t MAX_CACHED_TRANSITIONS = 8;
+
+const uint8_t NO_STATE = 0xff;
 
 typedef struct Event Event;
 typedef struct Result Result;
@@ -44,6 +48,23 @@ struct Result {
   State target;
 };
 
+// a state whose parent has been asked for, parents are indexes into the same
+// table so an ancestry is walked without calling any state
+struct StateNode {
+  State state;
+  uint8_t parent;
+  uint8_t depth;
+};
+
+// a transition that has been taken before, the common ancestor is where the
+// exits stop and the enters start
+struct TransitionPath {
+  State target;
+  uint8_t source;
+  uint8_t targetNode;
+  uint8_t commonAncestor;
+};
+
 class StateMachine {
 public:
   void initialize(State state);
@@ -53,15 +74,37 @@ public:
 
 private:
   State state;
-  uint8_t depth = 0;
+  uint8_t stateNode = NO_STATE;
+
+  // filled in as states are first seen, each state is asked for its parent
+  // once
+  StateNode nodes[MAX_STATES];
+  uint8_t nodeCount = 0;
+
+  // recently taken transitions, replaced oldest first
+  TransitionPath transitions[MAX_CACHED_TRANSITIONS];
+  uint8_t transitionCount = 0;
+  uint8_t nextTransition = 0;
+
+  // find `targetState` in `nodes`, adding it and its ancestors if this is the
+  // first time it's been seen, returns `NO_STATE` if there is no room or the
+  // hierarchy is too deep
+  uint8_t getNode(State targetState, uint8_t depth = 0);
+
+  // the deepest state that both nodes are in, `NO_STATE` if they don't share a
+  // root
+  uint8_t getCommonAncestor(uint8_t source, uint8_t target);
+
+  // looks the transition from the current state up in `transitions`, working
+  // it out and remembering it if it isn't there, returns false on error
+  bool getTransitionPath(State targetState, TransitionPath &path);
 
-  // enters all parents of the target state, used only once for initialization
-  void enterParentStates(State targetState);
+  // enters every state below `ancestor` down to and including `target`,
+  // returns false if a state failed to enter
+  bool enterStates(uint8_t ancestor, uint8_t target);
 
-  // derive the ancestory of `state` and store it in `ancestry`, returns the
-  // depth of the ancestory, assumes `ancestry` is initialized as an array of
-  // null pointers
-  uint8_t getAncestry(State targetState, State ancestry[]);
+  // enters the initial child states of the current state
+  void enterChildStates();
 
   // transitions from the current state to a new target State
   // exits and enters all parent states along the way
@@ -69,7 +112,7 @@ private:
 
   // recursive component of `handle`, pushes an event through a state and
   // handles the result
-  Result processEvent(State targetState, Event event);
+  Result processEvent(uint8_t node, Event event);
 };
 
 }  // namespace StateMachine
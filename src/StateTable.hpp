@@ -0,0 +1,293 @@
+// SPDX-FileCopyrightText: 2025 KOINSLOT, Inc.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef KYWY_LIB_STATE_TABLE
+#define KYWY_LIB_STATE_TABLE 1
+
+#include <stdint.h>
+
+#include "Actor.hpp"
+#include "StateMachine.hpp"
+
+namespace StateMachine {
+
+// one row per state, indexed by the state's number
+struct StateDeclaration {
+  uint8_t parent;  // `NO_STATE` for the root
+  uint8_t child;   // entered after this state, `NO_STATE` if it has none
+};
+
+// one row per transition, taken when `signal` reaches `source` while the
+// machine is in `source` or one of its substates
+struct TransitionDeclaration {
+  uint8_t source;
+  uint16_t signal;
+  uint8_t target;
+};
+
+// checks run on the tables at compile time
+
+constexpr bool validStates(const StateDeclaration *states, uint8_t stateCount) {
+  for (uint8_t i = 0; i < stateCount; i++) {
+    uint8_t parent = states[i].parent, child = states[i].child;
+    if (parent != NO_STATE && parent >= stateCount) {
+      return false;
+    }
+    if (child != NO_STATE && (child >= stateCount || states[child].parent != i)) {
+      return false;  // an initial child has to be one of the state's children
+    }
+
+    // every state has to reach a root within `MAX_STATE_DEPTH`
+    uint8_t depth = 0;
+    for (uint8_t state = parent; state != NO_STATE; state = states[state].parent) {
+      if (++depth == MAX_STATE_DEPTH) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+constexpr uint8_t rootOf(const StateDeclaration *states, uint8_t state) {
+  while (states[state].parent != NO_STATE) {
+    state = states[state].parent;
+  }
+  return state;
+}
+
+constexpr bool validTransitions(const StateDeclaration *states, uint8_t stateCount,
+                                const TransitionDeclaration *transitions, uint8_t transitionCount) {
+  for (uint8_t i = 0; i < transitionCount; i++) {
+    uint8_t source = transitions[i].source, target = transitions[i].target;
+    if (source >= stateCount || target >= stateCount) {
+      return false;
+    }
+    if (rootOf(states, source) != rootOf(states, target)) {
+      return false;  // needs a common ancestor
+    }
+  }
+  return true;
+}
+
+// A hierarchical state machine whose states and transitions are declared in
+// constexpr tables, the counterpart of `StateMachine` for when the hierarchy
+// is known up front. The tables are checked at compile time, ancestries and
+// each state's transitions are worked out by the compiler, and states are
+// plain numbers so the machine handles enters, exits and events with a
+// switch.
+//
+//   enum : uint8_t { ROOT, ALIVE, WALKING, JUMPING, DEAD, STATE_COUNT };
+//
+//   constexpr StateMachine::StateDeclaration playerStates[STATE_COUNT] = {
+//     /* ROOT    */ { NO_STATE, ALIVE },
+//     /* ALIVE   */ { ROOT, WALKING },
+//     ...
+//   };
+//   constexpr StateMachine::TransitionDeclaration playerTransitions[] = {
+//     { WALKING, JUMP, JUMPING },
+//     { ALIVE, HIT, DEAD },
+//     ...
+//   };
+//
+//   class Player : public StateMachine::StateTable<Player, playerStates, STATE_COUNT, playerTransitions,
+//                                                  sizeof(playerTransitions) / sizeof(playerTransitions[0])> {
+//     ...
+//   };
+//
+// A machine without transitions passes `nullptr, 0`.
+//
+// The machine passed as `Machine` may declare any of these publicly, they are
+// called with the state's number:
+//   void enter(uint8_t state);
+//   void exit(uint8_t state);
+//   ResultType react(uint8_t state, Event event);  // for events that aren't
+//                                                  // transitions, returns
+//                                                  // `RESULT_UNHANDLED` to pass
+//                                                  // the event to the parent
+//
+// Semantics follow `StateMachine`: an event goes to the current state first
+// and then up through its parents, a transition exits up to the common
+// ancestor and enters down to the target, then the initial children are
+// entered.
+template <typename Machine, const StateDeclaration *states, uint8_t stateCount,
+          const TransitionDeclaration *transitions, uint8_t transitionCount>
+class StateTable {
+  static_assert(stateCount > 0 && stateCount < NO_STATE, "state table needs between 1 and 254 states");
+  static_assert(validStates(states, stateCount),
+                "state table has a parent or child out of range, an initial child that "
+                "isn't a child, or a hierarchy deeper than MAX_STATE_DEPTH");
+  static_assert(validTransitions(states, stateCount, transitions, transitionCount),
+                "transition table has a state out of range or a transition between "
+                "states without a common ancestor");
+
+public:
+  // enters `initialState`, its parents and its initial children
+  void initialize(uint8_t initialState) {
+    if (initialState >= stateCount) {
+      return;  // TODO: error
+    }
+
+    enterStates(NO_STATE, initialState);
+    state = initialState;
+    enterChildStates();
+  };
+
+  ResultType handle(Event event) {
+    if (state == NO_STATE) {
+      return RESULT_ERROR;  // not initialized
+    }
+
+    for (uint8_t current = state; current != NO_STATE; current = states[current].parent) {
+      // only the current state's own transitions, in the order they're declared
+      for (uint8_t i = tables.firstTransition[current]; i < tables.firstTransition[current + 1]; i++) {
+        const TransitionDeclaration &row = transitions[tables.transitionsBySource[i]];
+        if (row.signal == event.signal) {
+          transition(row.target);
+          return RESULT_TRANSITION;
+        }
+      }
+
+      ResultType result = machine()->react(current, event);
+      if (result != RESULT_UNHANDLED) {
+        return result;
+      }
+    }
+
+    return RESULT_UNHANDLED;
+  };
+
+  // handles an actor message's signal, the message is available to the hooks
+  // as `message` while it's handled
+  ResultType handle(::Actor::Message *message) {
+    this->message = message;
+    ResultType result = handle(Event{ .signal = (uint16_t)message->signal });
+    this->message = nullptr;
+    return result;
+  };
+
+  uint8_t getState() {
+    return state;
+  };
+
+  // true if the machine is in `ancestor` or one of its substates
+  bool isIn(uint8_t ancestor) {
+    for (uint8_t current = state; current != NO_STATE; current = states[current].parent) {
+      if (current == ancestor) {
+        return true;
+      }
+    }
+    return false;
+  };
+
+  // defaults for the hooks the machine doesn't declare
+  void enter(uint8_t) {}
+  void exit(uint8_t) {}
+  ResultType react(uint8_t, Event) {
+    return RESULT_UNHANDLED;
+  };
+
+protected:
+  ::Actor::Message *message = nullptr;
+
+private:
+  uint8_t state = NO_STATE;
+
+  // worked out by the compiler from `states` and `transitions`
+  struct Tables {
+    uint8_t depth[stateCount];
+
+    // the rows of `transitions` sorted by source, state `s`'s rows are
+    // `transitionsBySource[firstTransition[s]]` up to the next state's first
+    uint8_t firstTransition[stateCount + 1];
+    uint8_t transitionsBySource[transitionCount ? transitionCount : 1];
+  };
+
+  static constexpr Tables buildTables() {
+    Tables built = {};
+    for (uint8_t i = 0; i < stateCount; i++) {
+      for (uint8_t parent = states[i].parent; parent != NO_STATE; parent = states[parent].parent) {
+        built.depth[i]++;
+      }
+    }
+
+    // counting sort, rows keep their declared order within a source
+    for (uint8_t i = 0; i < transitionCount; i++) {
+      built.firstTransition[transitions[i].source + 1]++;
+    }
+    for (uint8_t i = 0; i < stateCount; i++) {
+      built.firstTransition[i + 1] += built.firstTransition[i];
+    }
+    uint8_t filled[stateCount] = {};
+    for (uint8_t i = 0; i < transitionCount; i++) {
+      uint8_t source = transitions[i].source;
+      built.transitionsBySource[built.firstTransition[source] + filled[source]++] = i;
+    }
+    return built;
+  };
+
+  static constexpr Tables tables = buildTables();
+
+  Machine *machine() {
+    return static_cast<Machine *>(this);
+  };
+
+  uint8_t getCommonAncestor(uint8_t source, uint8_t target) {
+    while (tables.depth[source] > tables.depth[target]) {
+      source = states[source].parent;
+    }
+    while (tables.depth[target] > tables.depth[source]) {
+      target = states[target].parent;
+    }
+    while (source != target) {
+      source = states[source].parent;
+      target = states[target].parent;
+    }
+    return source;
+  };
+
+  // enters every state below `ancestor` down to and including `target`
+  void enterStates(uint8_t ancestor, uint8_t target) {
+    // the path is found bottom up and entered top down
+    uint8_t path[MAX_STATE_DEPTH];
+    uint8_t length = 0;
+    for (uint8_t i = target; i != ancestor; i = states[i].parent) {
+      path[length++] = i;
+    }
+
+    while (length) {
+      machine()->enter(path[--length]);
+    }
+  };
+
+  void enterChildStates() {
+    while (states[state].child != NO_STATE) {
+      state = states[state].child;
+      machine()->enter(state);
+    }
+  };
+
+  void transition(uint8_t target) {
+    uint8_t commonAncestor = getCommonAncestor(state, target);
+
+    // exit to common ancestor
+    for (uint8_t i = state; i != commonAncestor; i = states[i].parent) {
+      machine()->exit(i);
+    }
+
+    // enter to target state
+    enterStates(commonAncestor, target);
+    state = target;
+
+    enterChildStates();
+  };
+};
+
+template <typename Machine, const StateDeclaration *states, uint8_t stateCount,
+          const TransitionDeclaration *transitions, uint8_t transitionCount>
+constexpr typename StateTable<Machine, states, stateCount, transitions, transitionCount>::Tables
+  StateTable<Machine, states, stateCount, transitions, transitionCount>::tables;
+
+}  // namespace StateMachine
+
+#endif